@@ -0,0 +1,257 @@
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "DebugAPI/LineRenderer.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	// same as DebugAPI::DRAW_LOC_MAX_DIF in the plugin
+	constexpr float MAX_DIF = 5.0f;
+	constexpr std::uint64_t LIFETIME = 1000000;
+
+	// takes the draw list like the overlay movie would, without doing anything with it
+	class NullMovie : public OverlayMovie
+	{
+	public:
+		bool SupportsDrawList() const override { return true; }
+		void Invoke(const char*, const float*, std::uint32_t) override { InvokeCount++; }
+		void InvokeDrawList(const std::vector<float>& packed) override
+		{
+			benchmark::DoNotOptimize(packed.data());
+			InvokeCount++;
+		}
+	};
+
+	// a camera at the origin looking down +y onto a 1280x720 overlay. Row 3 is the view depth
+	CameraSnapshot MakeCamera(float yaw = 0.0f)
+	{
+		CameraSnapshot camera{};
+		const float c = std::cos(yaw);
+		const float s = std::sin(yaw);
+		const float WORLD_TO_CAM[4][4] = {
+			{ c, -s, 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.7777f, 0.0f },
+			{ s, c, 0.0f, -1.0f },
+			{ s, c, 0.0f, 0.0f },
+		};
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++) {
+				camera.WorldToCam[row][col] = WORLD_TO_CAM[row][col];
+			}
+		}
+
+		camera.PortLeft = 0.0f;
+		camera.PortRight = 1.0f;
+		camera.PortTop = 1.0f;
+		camera.PortBottom = 0.0f;
+		camera.RectRight = 1280.0f;
+		camera.RectBottom = 720.0f;
+		return camera;
+	}
+
+	// 16 segment circles in front of the camera, the kind of shapes mods draw, lineCount / 16 of them
+	std::vector<LineCommand> MakeCircles(std::uint32_t lineCount, std::uint64_t destroyTickCount)
+	{
+		const std::uint32_t colors[] = {
+			DebugAPILine::PackColor({ 1.0f, 0.0f, 0.0f, 1.0f }),
+			DebugAPILine::PackColor({ 0.0f, 1.0f, 0.0f, 1.0f }),
+			DebugAPILine::PackColor({ 0.0f, 0.0f, 1.0f, 1.0f }),
+			DebugAPILine::PackColor({ 1.0f, 1.0f, 1.0f, 0.5f }),
+		};
+
+		std::vector<LineCommand> commands;
+		commands.reserve(lineCount);
+		for (std::uint32_t circle = 0; commands.size() < lineCount; circle++) {
+			const float depth = 200.0f + (circle % 97) * 40.0f;
+			const glm::vec3 center((circle % 31) * depth * 0.05f - depth * 0.75f, depth, (circle % 17) * depth * 0.05f - depth * 0.4f);
+			for (std::uint32_t i = 0; i < 16 && commands.size() < lineCount; i++) {
+				auto point = [&](std::uint32_t j) {
+					const float angle = (j % 16) * (6.2831853f / 16.0f);
+					return center + glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * 30.0f;
+				};
+				commands.push_back({ point(i), point(i + 1), colors[circle % 4], 1.0f, destroyTickCount });
+			}
+		}
+		return commands;
+	}
+
+	// lines drawn with a lifetime and redrawn every frame, so every command refreshes a live line through the LineStore
+	void BM_PersistentLines(benchmark::State& state)
+	{
+		const auto lineCount = static_cast<std::uint32_t>(state.range(0));
+		const auto camera = MakeCamera();
+		const auto commands = MakeCircles(lineCount, LIFETIME);
+
+		LineRenderer renderer(MAX_DIF);
+		NullMovie movie;
+		renderer.Submit(commands);
+		renderer.RenderFrame(camera, 0, movie);
+
+		for (auto _ : state) {
+			renderer.Submit(commands);
+			renderer.RenderFrame(camera, 1, movie);
+		}
+
+		state.SetItemsProcessed(state.iterations() * lineCount);
+		state.counters["drawn"] = renderer.GetDrawnLineCount();
+	}
+
+	// lines with a lifetime of 0, redrawn every frame by their owner
+	void BM_TransientLines(benchmark::State& state)
+	{
+		const auto lineCount = static_cast<std::uint32_t>(state.range(0));
+		const auto camera = MakeCamera();
+		const auto commands = MakeCircles(lineCount, LineCommand::TRANSIENT);
+
+		LineRenderer renderer(MAX_DIF);
+		NullMovie movie;
+
+		std::uint64_t now = 0;
+		for (auto _ : state) {
+			renderer.Submit(commands);
+			renderer.RenderFrame(camera, ++now, movie);
+		}
+
+		state.SetItemsProcessed(state.iterations() * lineCount);
+		state.counters["drawn"] = renderer.GetDrawnLineCount();
+	}
+
+	// a retained batch while the camera turns, so every frame projects it again
+	void BM_BatchLines(benchmark::State& state)
+	{
+		const auto lineCount = static_cast<std::uint32_t>(state.range(0));
+
+		std::vector<LineRenderer::BatchLine> lines;
+		for (const auto& command : MakeCircles(lineCount, 0)) {
+			lines.push_back({ command.From, command.To, command.Color, command.Thickness });
+		}
+
+		LineRenderer renderer(MAX_DIF);
+		NullMovie movie;
+		renderer.CreateBatch(lines);
+
+		std::uint64_t now = 0;
+		for (auto _ : state) {
+			now++;
+			renderer.RenderFrame(MakeCamera((now % 2) * 0.01f), now, movie);
+		}
+
+		state.SetItemsProcessed(state.iterations() * lineCount);
+		state.counters["drawn"] = renderer.GetDrawnLineCount();
+	}
+
+	// DrawLineForMS from many threads while the game thread renders. Every producer submits its own circles one line at
+	// a time, so the live line count stays fixed and only the submission path differs between the two benchmarks
+	struct ConcurrentSubmit
+	{
+		static constexpr std::uint32_t LINES_PER_PRODUCER = 1024;
+		static constexpr std::uint32_t LINES_PER_ITERATION = 64;
+
+		explicit ConcurrentSubmit(std::uint32_t producers) :
+			Renderer(MAX_DIF)
+		{
+			// far enough apart that producers don't merge into each other's lines
+			for (std::uint32_t i = 0; i < producers; i++) {
+				auto commands = MakeCircles(LINES_PER_PRODUCER, LIFETIME);
+				for (auto& command : commands) {
+					command.From.z += i * 10000.0f;
+					command.To.z += i * 10000.0f;
+				}
+				Commands.push_back(std::move(commands));
+			}
+		}
+
+		// renders until Stop, frame runs one frame
+		template <class Func>
+		void Start(Func frame)
+		{
+			Consumer = std::thread([this, frame] {
+				for (std::uint64_t now = 1; !Stopped.load(std::memory_order_relaxed); now++) {
+					frame(now);
+					Frames.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+
+		void Stop()
+		{
+			Stopped.store(true, std::memory_order_relaxed);
+			Consumer.join();
+		}
+
+		LineRenderer Renderer;
+		NullMovie Movie;
+		const CameraSnapshot Camera = MakeCamera();
+		std::vector<std::vector<LineCommand>> Commands;
+
+		// the baseline's submission path, DrawLineForMS and Update took LinesToDraw_mutex before the submit queue
+		std::mutex LinesToDraw_mutex;
+		std::vector<LineCommand> LinesToDraw;
+
+		std::thread Consumer;
+		std::atomic<bool> Stopped{ false };
+		std::atomic<std::uint64_t> Frames{ 0 };
+	};
+
+	// set up by thread 0 before the first iteration, the benchmark's threads are synchronized around the loop
+	std::unique_ptr<ConcurrentSubmit> Shared;
+
+	template <bool LockFree>
+	void BM_ConcurrentSubmit(benchmark::State& state)
+	{
+		if (state.thread_index() == 0) {
+			Shared = std::make_unique<ConcurrentSubmit>(state.threads());
+			if constexpr (LockFree) {
+				Shared->Start([](std::uint64_t now) { Shared->Renderer.RenderFrame(Shared->Camera, now, Shared->Movie); });
+			} else {
+				// the frame held the lock from merging the lines until they were drawn
+				Shared->Start([](std::uint64_t now) {
+					std::lock_guard<std::mutex> lg(Shared->LinesToDraw_mutex);
+					Shared->Renderer.Submit(Shared->LinesToDraw);
+					Shared->LinesToDraw.clear();
+					Shared->Renderer.RenderFrame(Shared->Camera, now, Shared->Movie);
+				});
+			}
+		}
+
+		std::uint32_t next = 0;
+		for (auto _ : state) {
+			const auto& commands = Shared->Commands[state.thread_index()];
+			for (std::uint32_t i = 0; i < ConcurrentSubmit::LINES_PER_ITERATION; i++) {
+				const auto& command = commands[next++ % ConcurrentSubmit::LINES_PER_PRODUCER];
+				if constexpr (LockFree) {
+					Shared->Renderer.Submit(command);
+				} else {
+					std::lock_guard<std::mutex> lg(Shared->LinesToDraw_mutex);
+					Shared->LinesToDraw.push_back(command);
+				}
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * ConcurrentSubmit::LINES_PER_ITERATION);
+
+		if (state.thread_index() == 0) {
+			Shared->Stop();
+			state.counters["frames"] = benchmark::Counter(static_cast<double>(Shared->Frames), benchmark::Counter::kIsRate);
+			Shared.reset();
+		}
+	}
+
+	void BM_ConcurrentSubmitLockFree(benchmark::State& state) { BM_ConcurrentSubmit<true>(state); }
+	void BM_ConcurrentSubmitMutex(benchmark::State& state) { BM_ConcurrentSubmit<false>(state); }
+}
+
+BENCHMARK(BM_PersistentLines)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TransientLines)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchLines)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcurrentSubmitLockFree)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcurrentSubmitMutex)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "DebugAPI/LineSubmitQueue.h"
+#include "DebugAPI/Projection.h"
+
+namespace DebugAPI_IMPL
+{
+	// a recorded LineRenderer session: for every frame the tick count, the camera (including the movie's frame rect)
+	// and the commands drained in that frame, in drain order. Replaying the frames through a fresh LineRenderer
+	// reproduces the recorded frames exactly.
+	//
+	// The file is a header followed by frames, all little endian and written as is:
+	//   header: MAGIC, VERSION
+	//   frame:  now (u64), CameraSnapshot, commandCount (u32), LineCommand * commandCount
+	namespace Capture
+	{
+		static constexpr std::uint32_t MAGIC = 0x43524b43;  // "CKRC"
+		static constexpr std::uint32_t VERSION = 1;
+
+		static_assert(std::is_trivially_copyable_v<CameraSnapshot> && sizeof(CameraSnapshot) == 108);
+		static_assert(std::is_trivially_copyable_v<LineCommand> && sizeof(LineCommand) == 40);
+
+		struct Frame
+		{
+			std::uint64_t Now;
+			CameraSnapshot Camera;
+			std::vector<LineCommand> Commands;
+		};
+
+		class Writer
+		{
+		public:
+			// false if the file can't be created
+			bool Open(const std::filesystem::path& path);
+			bool IsOpen() const { return Stream.is_open(); }
+
+			void WriteFrame(std::uint64_t now, const CameraSnapshot& camera, std::span<const LineCommand> commands);
+
+		private:
+			std::ofstream Stream;
+		};
+
+		class Reader
+		{
+		public:
+			// false if the file can't be opened or isn't a capture of this version
+			bool Open(const std::filesystem::path& path);
+
+			// false at the end of the file, on a truncated frame or on a command count the rest of the file can't hold.
+			// frame.Commands keeps its capacity between calls
+			bool ReadFrame(Frame& frame);
+
+		private:
+			std::ifstream Stream;
+			std::uint64_t Size = 0;
+		};
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// what a DrawList is submitted to. GFxOverlayMovie forwards to the overlay movie, other implementations can count or
+	// record the calls without a running game
+	class OverlayMovie
+	{
+	public:
+		// the most arguments a DrawList passes to Invoke, the style of a lineStyle call
+		static constexpr std::uint32_t MAX_INVOKE_ARGS = 3;
+
+		virtual ~OverlayMovie() = default;
+
+		// true if the movie implements drawPolylines (see DrawList::Submit), otherwise the per-call fallback is used
+		virtual bool SupportsDrawList() const = 0;
+		// argCount is at most MAX_INVOKE_ARGS
+		virtual void Invoke(const char* method, const float* args, std::uint32_t argCount) = 0;
+		virtual void InvokeDrawList(const std::vector<float>& packed) = 0;
+
+		std::uint32_t InvokeCount = 0;
+	};
+
+	// all projected segments of a frame, grouped by line style, so they can be handed to the movie in one go. Segments of
+	// a group that share endpoints are chained into polylines, a circle is one moveTo and a lineTo per segment
+	class DrawList
+	{
+	public:
+		void Clear();
+		void AddLine(const glm::vec2& from, const glm::vec2& to, float color, float lineThickness, float alpha);
+
+		// with drawPolylines available this is a single Invoke for the whole frame. The packed array is
+		//   [groupCount, { thickness, color, alpha, polylineCount, { pointCount, { x, y } * pointCount } * polylineCount }
+		//   * groupCount]
+		// otherwise it falls back to one lineStyle per group, a moveTo per polyline and a lineTo per following point
+		void Submit(OverlayMovie& movie);
+
+		std::uint32_t GetLineCount() const { return LineCount; }
+		// polylines of the last Submit
+		std::uint32_t GetPolylineCount() const { return PolylineCount; }
+
+	private:
+		// endpoints closer than 1 / POINT_GRID movie pixels count as shared
+		static constexpr float POINT_GRID = 8.0f;
+		static constexpr std::uint32_t INVALID_INDEX = ~0u;
+
+		struct StyleGroup
+		{
+			float Thickness;
+			float Color;
+			float Alpha;
+			std::vector<glm::vec4> Segments;
+
+			// built from Segments by BuildPolylines
+			std::vector<glm::vec2> Points;
+			std::vector<std::uint32_t> PolylineSizes;
+		};
+
+		// greedy: starting at any unused segment, walks backwards and then forwards over unused segments sharing the
+		// current endpoint. Linear in the segment count
+		void BuildPolylines(StyleGroup& group);
+
+		// groups are reused between frames so their segment vectors keep their capacity
+		std::vector<StyleGroup> Groups;
+		std::uint32_t GroupCount = 0;
+		std::uint32_t LastGroup = 0;
+		std::uint32_t LineCount = 0;
+		std::uint32_t PolylineCount = 0;
+		std::vector<float> Packed;
+
+		// BuildPolylines scratch. Endpoint e is end e % 2 of segment e / 2. The table is open addressing over the
+		// quantized point, each bucket heads a list of the endpoints at that point (EndpointNext)
+		std::vector<std::uint64_t> BucketKeys;
+		std::vector<std::uint32_t> BucketHeads;
+		std::vector<std::uint32_t> EndpointBucket;
+		std::vector<std::uint32_t> EndpointNext;
+		std::vector<std::uint8_t> SegmentUsed;
+		std::vector<glm::vec2> BackwardPoints;
+	};
+}
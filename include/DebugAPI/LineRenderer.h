@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "DebugAPI/Capture.h"
+#include "DebugAPI/DrawList.h"
+#include "DebugAPI/LineStore.h"
+#include "DebugAPI/LineSubmitQueue.h"
+#include "DebugAPI/PerfCounters.h"
+#include "DebugAPI/Projection.h"
+
+namespace DebugAPI_IMPL
+{
+	// how much of a frame the overlay may take. Lines over budget are dropped, the ones with the smallest priority
+	// (see LineRenderer::Candidate) first
+	struct FrameBudget
+	{
+		// 0 is unlimited
+		std::uint32_t MaxLines = 0;
+		// 0 is unlimited. Turned into a line count with the measured cost per drawn line of the previous frames
+		std::uint32_t MaxMicroseconds = 0;
+		// segments shorter than this on screen (in movie units, i.e. pixels at the movie's native size) are dropped
+		float MinScreenLength = 1.0f;
+	};
+
+	// everything DebugAPI::Update does that doesn't need the game: merges the submitted lines into the live ones,
+	// clips and projects them with the frame's camera and submits the result to the movie. DebugAPI only captures the
+	// camera and wraps the overlay movie, so this can be driven with a fake camera and movie as well
+	class LineRenderer
+	{
+	public:
+		explicit LineRenderer(float maxDif);
+
+		// thread safe and lock-free, the lines show up in the next RenderFrame
+		void Submit(const LineCommand& command) { SubmitQueue.Push(command); }
+		void Submit(std::span<const LineCommand> commands) { SubmitQueue.Push(commands); }
+
+		// now is the tick count DestroyTickCount is compared against. Calls "clear" on the movie first
+		void RenderFrame(const CameraSnapshot& camera, std::uint64_t now, OverlayMovie& movie);
+		// for frames with nothing to draw into: merges and expires the submitted lines like RenderFrame, but draws nothing
+		// and drops the transient ones. Otherwise the submit queue fills up until the overlay is back
+		void SkipFrame(std::uint64_t now);
+
+		void SetBudget(const FrameBudget& budget);
+
+		// a line of a retained batch, in the batch's local space
+		struct BatchLine
+		{
+			glm::vec3 From;
+			glm::vec3 To;
+			std::uint32_t Color;
+			float Thickness;
+		};
+
+		using BatchHandle = std::uint32_t;
+		static constexpr BatchHandle INVALID_BATCH = 0;
+
+		// retained geometry for lines that don't change every frame. A batch stays resident until DestroyBatch, so unlike
+		// submitted lines it never goes through the submit queue and the LineStore dedup again. Its lines are only
+		// transformed again after SetBatchTransform and only projected again when the batch or the camera changed. All of
+		// these are thread safe, changes show up in the next RenderFrame. Batches aren't recorded by Capture
+		BatchHandle CreateBatch(std::span<const BatchLine> lines, const glm::mat4& transform = glm::mat4(1.0f));
+		// local to world. False if the batch doesn't exist (anymore), same for the other setters
+		bool SetBatchTransform(BatchHandle batch, const glm::mat4& transform);
+		bool SetBatchVisible(BatchHandle batch, bool visible);
+		// draws every line of the batch in color instead of its own, std::nullopt goes back to the lines' own colors
+		bool SetBatchColor(BatchHandle batch, std::optional<std::uint32_t> color);
+		bool DestroyBatch(BatchHandle batch);
+
+		// records every following frame to path until StopCapture, see Capture. False if the file can't be created
+		bool StartCapture(const std::filesystem::path& path);
+		void StopCapture();
+
+		std::uint32_t GetLiveLineCount() const { return LinesToDraw.Size(); }
+		std::uint32_t GetDrawnLineCount() const { return FrameDrawList.GetLineCount(); }
+		std::uint32_t GetBatchCount();
+
+		// RenderFrame counts and times itself here, other stages of the overlay can record into it as well
+		PerfCounters& GetCounters() { return Counters; }
+
+	private:
+		// returns true if there is already a line with the same color at around the same from and to position
+		// with some leniency to bundle together lines in roughly the same spot (see DebugAPI::DRAW_LOC_MAX_DIF).
+		// LinesToDraw_mutex must be held by the caller. Returns LineStore::INVALID_INDEX if there is none
+		std::uint32_t GetExistingLine(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float lineThickness);
+		// merges a drained command into LinesToDraw, returns true if it refreshed an existing line. LinesToDraw_mutex
+		// must be held by the caller
+		bool ApplyCommand(const LineCommand& command);
+
+		// Submit only pushes into SubmitQueue, LinesToDraw_mutex just keeps two RenderFrames from running at once
+		LineSubmitQueue SubmitQueue;
+		std::mutex LinesToDraw_mutex;
+		LineStore LinesToDraw;
+		TransientLineBuffer TransientLines;
+		// tick of the RenderFrame that received the current TransientLines
+		std::uint64_t TransientTickCount = 0;
+		// a visible segment of this frame, drawn unless it is over budget
+		struct Candidate
+		{
+			glm::vec2 From;
+			glm::vec2 To;
+			std::uint32_t Color;
+			float Thickness;
+			// screen length, scaled down with distance so close lines win over far ones of the same screen length
+			float Priority;
+		};
+
+		enum class Visibility
+		{
+			kVisible,
+			kCulled,
+			kTooShort
+		};
+
+		// clips a segment given in clip space and appends it to candidates if enough of it is visible
+		Visibility AddCandidate(const CameraSnapshot& camera, glm::vec4 clipFrom, glm::vec4 clipTo, std::uint32_t color,
+			float thickness, std::vector<Candidate>& candidates) const;
+
+		struct Batch
+		{
+			std::vector<BatchLine> Lines;
+			glm::mat4 Transform;
+			std::optional<std::uint32_t> Color;
+			bool Visible = true;
+			// Points is out of date with Transform
+			bool Moved = true;
+			// Candidates is out of date with the batch, regardless of the camera
+			bool Changed = true;
+
+			// world space From and To of every line
+			std::vector<glm::vec3> Points;
+			// the visible lines as of the last projection, and what the projection dropped
+			std::vector<Candidate> Candidates;
+			std::uint32_t Culled = 0;
+			std::uint32_t TooShort = 0;
+		};
+
+		// projects the batches that changed, or all of them if the camera did, and appends the lines of every visible
+		// batch to FrameCandidates. LinesToDraw_mutex must be held by the caller
+		void AddBatches(const CameraSnapshot& camera, std::uint32_t& culled, std::uint32_t& tooShort);
+
+		// taken by the batch setters and by AddBatches, after LinesToDraw_mutex
+		std::mutex Batches_mutex;
+		std::unordered_map<BatchHandle, Batch> Batches;
+		BatchHandle NextBatch = INVALID_BATCH + 1;
+		// camera and FrameBudget::MinScreenLength the batches were last projected with
+		CameraSnapshot BatchCamera{};
+		float BatchMinScreenLength = -1.0f;
+		std::vector<glm::vec4> BatchClipPoints;
+
+		// distance at which the priority of a line is halved
+		static constexpr float PRIORITY_HALF_DISTANCE = 4096.0f;
+		// the time budget never cuts a frame down to fewer lines than this
+		static constexpr std::size_t MIN_BUDGET_LINES = 256;
+		// frames with fewer drawn lines don't update LineCostMicroseconds, the fixed costs would dominate
+		static constexpr std::uint32_t MIN_LINE_COST_SAMPLES = 64;
+
+		// how many of this frame's candidates can be drawn. elapsed is the time the frame took so far
+		std::size_t GetLineCap(float elapsedMicroseconds) const;
+
+		DrawList FrameDrawList;
+		std::vector<glm::vec3> FramePoints;
+		std::vector<glm::vec4> FrameClipPoints;
+		std::vector<Candidate> FrameCandidates;
+
+		FrameBudget Budget;
+		// moving average of the time AddLine and Submit take per drawn line
+		float LineCostMicroseconds = 0.0f;
+
+		PerfCounters Counters;
+
+		std::unique_ptr<Capture::Writer> CaptureWriter;
+		// the commands drained this frame, only collected while capturing
+		std::vector<LineCommand> CaptureCommands;
+	};
+}
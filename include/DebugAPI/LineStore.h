@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// a live line, stored by value in LineStore. Kept small on purpose, a dense navmesh easily has tens of thousands
+	// of these: color is packed RGBA8 and the thickness is stored in 1/16th of a pixel
+	struct DebugAPILine
+	{
+		glm::vec3 From;
+		glm::vec3 To;
+		std::uint32_t Color;
+		std::uint16_t Thickness;
+		// LineStore timing wheel slot the line is scheduled in
+		std::uint16_t WheelSlot;
+
+		// next line in the same LineStore bucket, LineStore::INVALID_INDEX terminates the chain
+		std::uint32_t NextInBucket;
+		// insertion order, used to resolve ties between several matching lines the same way the old in-order scan did
+		std::uint32_t Sequence;
+
+		// neighbours in the timing wheel slot, LineStore::INVALID_INDEX at either end
+		std::uint32_t WheelPrev;
+		std::uint32_t WheelNext;
+
+		std::uint64_t DestroyTickCount;
+
+		static std::uint32_t PackColor(const glm::vec4& color);
+		static std::uint16_t PackThickness(float lineThickness);
+
+		float GetThickness() const { return Thickness * (1.0f / 16.0f); }
+		// color as the 0xRRGGBB number expected by lineStyle
+		float GetHexColor() const { return GetHexColor(Color); }
+		// alpha in the 0-100 range expected by lineStyle
+		float GetAlpha() const { return GetAlpha(Color); }
+
+		static float GetHexColor(std::uint32_t color) { return static_cast<float>(color >> 8); }
+		static float GetAlpha(std::uint32_t color) { return (color & 0xff) * (100.0f / 255.0f); }
+	};
+	static_assert(sizeof(DebugAPILine) == 56);
+
+	// dense, pooled storage for the live lines plus a spatial hash over them, so GetExistingLine doesn't have to
+	// compare against every line.
+	//
+	// Lines are kept by value in one vector that only ever grows, removal is swap-and-pop. The hash buckets lines by
+	// the quantized position of their start point (cell size == maxDif) and their color. Any line within maxDif of a
+	// query point can only be in the neighbouring cells, so a lookup probes at most 3x3x3 buckets and then runs the
+	// exact same leniency check as the old linear scan. Buckets are chained through DebugAPILine::NextInBucket, so
+	// nothing is allocated per line.
+	//
+	// Expiry is scheduled on a hashed timing wheel keyed on DestroyTickCount, so Expire only looks at the slots that
+	// elapsed since the last frame instead of every live line, and refreshing a line just moves it to another slot
+	class LineStore
+	{
+	public:
+		static constexpr std::uint32_t INVALID_INDEX = 0xffffffff;
+
+		explicit LineStore(float maxDif);
+
+		// if several lines match, returns the one that was added first
+		std::uint32_t Find(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float lineThickness) const;
+
+		std::uint32_t Add(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float lineThickness,
+			std::uint64_t destroyTickCount);
+		void Refresh(std::uint32_t index, const glm::vec3& from, const glm::vec3& to, float lineThickness,
+			std::uint64_t destroyTickCount);
+		// moves the last line into index, so callers iterating forward must revisit index
+		void Remove(std::uint32_t index);
+		// removes every line with now > DestroyTickCount
+		void Expire(std::uint64_t now);
+		void Clear();
+
+		std::uint32_t Size() const { return static_cast<std::uint32_t>(Lines.size()); }
+		const DebugAPILine& operator[](std::uint32_t index) const { return Lines[index]; }
+
+	private:
+		std::int32_t Quantize(float value) const;
+		static std::uint64_t MakeKey(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t color);
+		std::uint32_t& GetHead(std::uint64_t key) { return Heads[key & (Heads.size() - 1)]; }
+		std::uint32_t GetHead(std::uint64_t key) const { return Heads[key & (Heads.size() - 1)]; }
+		std::uint64_t GetKey(const DebugAPILine& line) const;
+
+		void Link(std::uint32_t index);
+		void Unlink(std::uint32_t index);
+		void Rehash(std::size_t headCount);
+
+		// 256 slots of 16ms each, lines further out than one revolution (~4s) are simply skipped until their turn
+		static constexpr std::uint32_t WHEEL_SLOTS = 256;
+		static constexpr std::uint64_t WHEEL_SLOT_MS = 16;
+
+		void Schedule(std::uint32_t index);
+		void Unschedule(std::uint32_t index);
+
+		float MaxDif;
+		std::uint32_t NextSequence = 0;
+		std::vector<DebugAPILine> Lines;
+		std::vector<std::uint32_t> Heads;
+
+		std::array<std::uint32_t, WHEEL_SLOTS> WheelHeads;
+		// WheelSlot time (tick / WHEEL_SLOT_MS) Expire has processed up to, that slot itself is visited again
+		std::uint64_t WheelTime = 0;
+		std::vector<std::uint32_t> Expired;
+	};
+}
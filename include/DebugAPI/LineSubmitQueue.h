@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// a DrawLineForMS call, queued until the next DebugAPI::Update picks it up
+	struct LineCommand
+	{
+		// DestroyTickCount of lines drawn with a lifetime of 0, those go to the TransientLineBuffer
+		static constexpr std::uint64_t TRANSIENT = 0;
+
+		glm::vec3 From;
+		glm::vec3 To;
+		std::uint32_t Color;
+		float Thickness;
+		std::uint64_t DestroyTickCount;
+	};
+
+	// lines with a lifetime of 0, i.e. redrawn by their owner every frame. They skip the dedup and the expiry checks of
+	// LineStore entirely, the buffer is simply reset once the frame that submitted them is over
+	class TransientLineBuffer
+	{
+	public:
+		void Reset() { Count = 0; }
+
+		void Append(const LineCommand& command)
+		{
+			if (Count == Lines.size()) {
+				Lines.resize(std::max<std::size_t>(1024, Lines.size() * 2));
+			}
+
+			Lines[Count++] = command;
+		}
+
+		std::uint32_t Size() const { return Count; }
+		const LineCommand& operator[](std::uint32_t index) const { return Lines[index]; }
+
+	private:
+		// only grows, so a steady per-frame overlay costs nothing but the appends
+		std::vector<LineCommand> Lines;
+		std::uint32_t Count = 0;
+	};
+
+	// lock-free multi producer, single consumer queue of LineCommands.
+	//
+	// Every producer thread gets its own chunked single producer queue the first time it pushes, so producers only ever
+	// write to their own chunks and never wait on each other or on the consumer. Drain walks all producer queues and
+	// hands back every command published so far; fully consumed chunks go back to their producer's free list.
+	// The queue of an exited thread is handed to the next thread that starts pushing, so there are only ever as many
+	// producer queues as threads pushed at the same time. A producer with MAX_PENDING_CHUNKS chunks nobody drained yet
+	// drops what it pushes on top, see TakeDroppedCount
+	class LineSubmitQueue
+	{
+	public:
+		// per producer, about 10MB of commands
+		static constexpr std::uint32_t MAX_PENDING_CHUNKS = 256;
+
+		LineSubmitQueue() = default;
+		LineSubmitQueue(const LineSubmitQueue&) = delete;
+		LineSubmitQueue& operator=(const LineSubmitQueue&) = delete;
+		// no producer may push anymore, threads that did still free their queues when they exit
+		~LineSubmitQueue();
+
+		void Push(const LineCommand& command);
+		void Push(std::span<const LineCommand> commands);
+
+		// single consumer only
+		template <class Func>
+		void Drain(Func&& func);
+
+		// commands dropped since the last call
+		std::uint32_t TakeDroppedCount() { return Dropped.exchange(0, std::memory_order_relaxed); }
+		// producer queues, including the ones of exited threads nobody claimed yet
+		std::uint32_t GetProducerCount() const;
+
+	private:
+		struct Chunk
+		{
+			static constexpr std::uint32_t CAPACITY = 1024;
+
+			LineCommand Commands[CAPACITY];
+			// number of published commands, written by the producer only
+			std::atomic<std::uint32_t> Count{ 0 };
+			// set by the producer once the chunk is full and it moved on
+			std::atomic<Chunk*> Next{ nullptr };
+			// free list link, written by the consumer before the chunk is published to the free list
+			Chunk* NextFree = nullptr;
+		};
+
+		struct ProducerQueue
+		{
+			// Id of the LineSubmitQueue
+			std::uint64_t Owner = 0;
+			ProducerQueue* NextQueue = nullptr;
+
+			// the LineSubmitQueue and the thread pushing hold one each, whichever lets go last frees the queue
+			std::atomic<std::uint32_t> References{ 1 };
+			// cleared when the thread exits, the next new producer claims the queue then
+			std::atomic<bool> Claimed{ true };
+
+			// producer side
+			Chunk* Tail = nullptr;
+
+			// consumer side
+			Chunk* Head = nullptr;
+			std::uint32_t ReadPos = 0;
+
+			// chunks linked behind Head, counted up by the producer and down by the consumer
+			std::atomic<std::uint32_t> PendingChunks{ 0 };
+
+			// pushed by the consumer, popped by the producer. With exactly one of each there is no ABA
+			std::atomic<Chunk*> FreeChunks{ nullptr };
+		};
+
+		// the producer queues of a thread, released when it exits
+		struct ThreadQueues
+		{
+			~ThreadQueues();
+
+			ProducerQueue* Find(std::uint64_t owner) const;
+			// also releases the queues of destroyed LineSubmitQueues, only this thread holds those anymore
+			void Add(ProducerQueue* queue);
+
+			std::vector<ProducerQueue*> Queues;
+		};
+
+		ProducerQueue& GetProducerQueue();
+		// an exited thread's queue, nullptr if there is none
+		ProducerQueue* ClaimProducerQueue();
+		static void ReleaseProducerQueue(ProducerQueue* queue);
+		// nullptr if the producer already has MAX_PENDING_CHUNKS
+		static Chunk* AllocateChunk(ProducerQueue& queue);
+
+		static inline std::atomic<std::uint64_t> NextId{ 1 };
+		const std::uint64_t Id = NextId.fetch_add(1, std::memory_order_relaxed);
+
+		std::atomic<ProducerQueue*> Queues{ nullptr };
+		std::atomic<std::uint32_t> Dropped{ 0 };
+	};
+
+	template <class Func>
+	void LineSubmitQueue::Drain(Func&& func)
+	{
+		for (auto queue = Queues.load(std::memory_order_acquire); queue; queue = queue->NextQueue) {
+			Chunk* head = queue->Head;
+			while (true) {
+				const auto count = head->Count.load(std::memory_order_acquire);
+				for (; queue->ReadPos < count; queue->ReadPos++) {
+					func(head->Commands[queue->ReadPos]);
+				}
+
+				if (count < Chunk::CAPACITY)
+					break;
+
+				// full, but the producer hasn't linked the next chunk yet
+				Chunk* next = head->Next.load(std::memory_order_acquire);
+				if (!next)
+					break;
+
+				// the producer has moved on and won't touch this chunk until it pops it from the free list again
+				head->NextFree = queue->FreeChunks.load(std::memory_order_relaxed);
+				while (!queue->FreeChunks.compare_exchange_weak(head->NextFree, head, std::memory_order_release,
+					std::memory_order_relaxed)) {
+				}
+				queue->PendingChunks.fetch_sub(1, std::memory_order_relaxed);
+
+				head = next;
+				queue->ReadPos = 0;
+			}
+
+			queue->Head = head;
+		}
+	}
+}
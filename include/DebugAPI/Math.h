@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace DebugAPI_IMPL
+{
+	glm::highp_mat4 GetRotationMatrix(glm::vec3 eulerAngles);
+	glm::vec3 NormalizeVector(glm::vec3 p);
+
+	glm::vec3 RotateVector(glm::quat quatIn, glm::vec3 vecIn);
+	glm::vec3 RotateVector(glm::vec3 eulerIn, glm::vec3 vecIn);
+
+	glm::vec3 GetForwardVector(glm::quat quatIn);
+	glm::vec3 GetForwardVector(glm::vec3 eulerIn);
+	glm::vec3 GetRightVector(glm::quat quatIn);
+	glm::vec3 GetRightVector(glm::vec3 eulerIn);
+
+	glm::vec3 ThreeAxisRotation(float r11, float r12, float r21, float r31, float r32);
+
+	bool IsRoughlyEqual(float first, float second, float maxDif);
+
+	glm::vec3 QuatToEuler(glm::quat q);
+	glm::quat EulerToQuat(glm::vec3 rotIn);
+
+	glm::vec3 GetInverseRotation(glm::vec3 rotIn);
+	glm::quat GetInverseRotation(glm::quat rotIn);
+
+	glm::vec3 EulerRotationToVector(glm::vec3 rotIn);
+	glm::vec3 VectorToEulerRotation(glm::vec3 vecIn);
+
+	glm::vec3 GetPointOnRotatedCircle(glm::vec3 origin, float radius, float i, float maxI, glm::vec3 eulerAngles);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// finds broken triangles in raw navmesh data (as read from the game or a NavmeshExport file, before
+	// NavmeshGeometry::Build drops anything). Meshes are independent, Analyze checks them in parallel
+	namespace NavmeshAnalyzer
+	{
+		enum Issue : std::uint8_t
+		{
+			// references a vertex that doesn't exist
+			kBadIndex,
+			// repeats a vertex or has (almost) no area
+			kDegenerate,
+			// has area, but is so thin it's effectively a line, see Thresholds::MinQuality
+			kSliver,
+			// uses a vertex that sits on top of another vertex of the mesh, the triangles around it don't connect
+			kDuplicateVertex,
+			// has an edge shared by more than two triangles
+			kNonManifoldEdge,
+			// in a group of edge connected triangles smaller than Thresholds::MaxIslandArea, other than the mesh's largest
+			// group
+			kIsland,
+
+			kIssueCount
+		};
+
+		const char* GetIssueName(Issue issue);
+
+		struct Thresholds
+		{
+			// game units squared
+			float MinArea = 1.0f;
+			// 4 * sqrt(3) * area / sum of squared edge lengths, 1 for an equilateral triangle and 0 for a line
+			float MinQuality = 0.05f;
+			// vertices closer than this are duplicates
+			float DuplicateDistance = 1.0f;
+			// game units squared, the total area of a group of triangles below which it's an island
+			float MaxIslandArea = 4096.0f;
+		};
+
+		struct MeshInput
+		{
+			std::uint32_t Key;
+			std::span<const glm::vec3> Vertices;
+			std::span<const std::array<std::uint32_t, 3>> Triangles;
+		};
+
+		struct Finding
+		{
+			std::uint32_t Triangle;
+			Issue Kind;
+		};
+
+		struct MeshReport
+		{
+			std::uint32_t Key;
+			// by triangle, a triangle can have several
+			std::vector<Finding> Findings;
+		};
+
+		struct Report
+		{
+			// only meshes with findings, in input order
+			std::vector<MeshReport> Meshes;
+			std::array<std::uint64_t, kIssueCount> Counts{};
+			std::uint64_t MeshCount = 0;
+			std::uint64_t TriangleCount = 0;
+		};
+
+		MeshReport AnalyzeMesh(const MeshInput& mesh, const Thresholds& thresholds);
+
+		// one task per mesh, largest meshes first so a big one doesn't end up last on an otherwise idle pool
+		Report Analyze(std::span<const MeshInput> meshes, const Thresholds& thresholds);
+	}
+}
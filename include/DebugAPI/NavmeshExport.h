@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// the navmeshes of one world as they are in the game, for tools that work on real geometry without the game. The
+	// file is laid out so it can be mapped and used in place, nothing is parsed on load.
+	//
+	// All little endian, every section starts at a multiple of SECTION_ALIGNMENT:
+	//   Header
+	//   Cell * CellCount          sorted by FormID, each owns the meshes [FirstMesh, FirstMesh + MeshCount)
+	//   Mesh * MeshCount          grouped by cell, each owns a range of the vertex and triangle arrays
+	//   glm::vec3 * VertexCount
+	//   Triangle * TriangleCount  indices into the mesh's own vertices, not validated (see NavmeshGeometry::Build)
+	namespace NavmeshExport
+	{
+		static constexpr std::uint32_t MAGIC = 0x4d4e4b43;  // "CKNM"
+		static constexpr std::uint32_t VERSION = 1;
+		static constexpr std::uint64_t SECTION_ALIGNMENT = 16;
+
+		// Cell::X and Y of interior cells
+		static constexpr std::int32_t INTERIOR = std::numeric_limits<std::int32_t>::min();
+
+		using Triangle = std::array<std::uint32_t, 3>;
+
+		struct Header
+		{
+			std::uint32_t Magic;
+			std::uint32_t Version;
+			// worldspace or interior cell
+			std::uint32_t WorldFormID;
+			std::uint32_t CellCount;
+			std::uint32_t MeshCount;
+			std::uint32_t Reserved;
+			std::uint64_t VertexCount;
+			std::uint64_t TriangleCount;
+			// byte offsets from the start of the file
+			std::uint64_t CellOffset;
+			std::uint64_t MeshOffset;
+			std::uint64_t VertexOffset;
+			std::uint64_t TriangleOffset;
+			std::uint64_t FileSize;
+			// editor ID, null terminated
+			char WorldName[64];
+		};
+
+		struct Cell
+		{
+			std::uint32_t FormID;
+			std::int32_t X;
+			std::int32_t Y;
+			std::uint32_t FirstMesh;
+			std::uint32_t MeshCount;
+		};
+
+		struct Mesh
+		{
+			std::uint32_t FormID;
+			// index into the cells
+			std::uint32_t Cell;
+			std::uint32_t VertexCount;
+			std::uint32_t TriangleCount;
+			std::uint64_t FirstVertex;
+			std::uint64_t FirstTriangle;
+		};
+
+		static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 144);
+		static_assert(sizeof(Cell) == 20 && sizeof(Mesh) == 32);
+		static_assert(sizeof(glm::vec3) == 12 && sizeof(Triangle) == 12);
+
+		// collects meshes in memory, Write lays them out
+		class Writer
+		{
+		public:
+			// a mesh already added (same FormID) is replaced
+			void AddMesh(std::uint32_t formID, std::uint32_t cellFormID, std::int32_t cellX, std::int32_t cellY,
+				std::span<const glm::vec3> vertices, std::span<const Triangle> triangles);
+			bool HasMesh(std::uint32_t formID) const { return Slots.contains(formID); }
+			std::size_t GetMeshCount() const { return Meshes.size(); }
+			void Clear()
+			{
+				Meshes.clear();
+				Slots.clear();
+			}
+
+			// false if the file can't be written
+			bool Write(const std::filesystem::path& path, std::uint32_t worldFormID, const std::string& worldName) const;
+
+		private:
+			struct PendingMesh
+			{
+				std::uint32_t FormID;
+				std::uint32_t CellFormID;
+				std::int32_t CellX;
+				std::int32_t CellY;
+				std::vector<glm::vec3> Vertices;
+				std::vector<Triangle> Triangles;
+			};
+
+			std::vector<PendingMesh> Meshes;
+			// FormID to index into Meshes
+			std::unordered_map<std::uint32_t, std::size_t> Slots;
+		};
+
+		// a mapped export. Open checks the header and that every range lies within the file, after that the accessors
+		// point straight into the mapping
+		class View
+		{
+		public:
+			View() = default;
+			View(const View&) = delete;
+			View& operator=(const View&) = delete;
+			~View() { Close(); }
+
+			// false if the file can't be mapped or isn't a valid export of this version
+			bool Open(const std::filesystem::path& path);
+			void Close();
+
+			const Header& GetHeader() const { return *reinterpret_cast<const Header*>(Data); }
+			std::span<const Cell> GetCells() const { return { Get<Cell>(GetHeader().CellOffset), GetHeader().CellCount }; }
+			std::span<const Mesh> GetMeshes() const { return { Get<Mesh>(GetHeader().MeshOffset), GetHeader().MeshCount }; }
+
+			std::span<const Mesh> GetMeshes(const Cell& cell) const
+			{
+				return GetMeshes().subspan(cell.FirstMesh, cell.MeshCount);
+			}
+			std::span<const glm::vec3> GetVertices(const Mesh& mesh) const
+			{
+				return { Get<glm::vec3>(GetHeader().VertexOffset) + mesh.FirstVertex, mesh.VertexCount };
+			}
+			std::span<const Triangle> GetTriangles(const Mesh& mesh) const
+			{
+				return { Get<Triangle>(GetHeader().TriangleOffset) + mesh.FirstTriangle, mesh.TriangleCount };
+			}
+
+		private:
+			template <class T>
+			const T* Get(std::uint64_t offset) const
+			{
+				return reinterpret_cast<const T*>(Data + offset);
+			}
+
+			bool Validate() const;
+
+			const std::uint8_t* Data = nullptr;
+			std::uint64_t Size = 0;
+#ifdef _WIN32
+			void* File = nullptr;
+			void* Mapping = nullptr;
+#endif
+		};
+	}
+}
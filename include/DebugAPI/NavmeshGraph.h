@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "DebugAPI/NavmeshGrid.h"
+
+namespace DebugAPI_IMPL
+{
+	// the triangles of a set of navmeshes compiled into one adjacency graph in CSR form: the links of node n are
+	// Links[Offsets[n], Offsets[n + 1]). Triangles sharing an edge are linked through it, and so are boundary edges of
+	// different navmeshes that lie on top of each other, which is how navmeshes meet at cell borders
+	class NavmeshGraph
+	{
+	public:
+		static constexpr std::uint32_t INVALID_NODE = ~0u;
+		// boundary edge endpoints are matched on a grid this size
+		static constexpr float PORTAL_GRID = 4.0f;
+		// FindNode grid
+		static constexpr float CELL_SIZE = 512.0f;
+
+		struct Link
+		{
+			std::uint32_t Node;
+			// centroid to centroid
+			float Cost;
+			// middle of the shared edge
+			glm::vec3 Portal;
+		};
+
+		void Build(std::span<const NavmeshGeometry* const> meshes);
+
+		std::uint32_t GetNodeCount() const { return static_cast<std::uint32_t>(Centroids.size()); }
+		const glm::vec3& GetCentroid(std::uint32_t node) const { return Centroids[node]; }
+		std::span<const Link> GetLinks(std::uint32_t node) const
+		{
+			return { Links.data() + Offsets[node], Links.data() + Offsets[node + 1] };
+		}
+
+		// the triangle whose XY contains position, the one closest in Z if several do. Otherwise the closest centroid in
+		// position's grid cell, INVALID_NODE if the cell is empty or position is out of bounds
+		std::uint32_t FindNode(const glm::vec3& position) const;
+
+	private:
+		static std::int32_t Quantize(float value) { return static_cast<std::int32_t>(std::floor(value / CELL_SIZE)); }
+		static std::uint64_t MakeKey(std::int32_t x, std::int32_t y)
+		{
+			return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+		}
+
+		std::vector<glm::vec3> Centroids;
+		std::vector<std::array<glm::vec3, 3>> Corners;
+		std::vector<std::uint32_t> Offsets;
+		std::vector<Link> Links;
+
+		// FindNode grid cell to a range of CellNodes
+		std::unordered_map<std::uint64_t, std::pair<std::uint32_t, std::uint32_t>> Cells;
+		std::vector<std::uint32_t> CellNodes;
+	};
+
+	// A* over a NavmeshGraph, from the node under one position to the node under another. The per node state and the open
+	// set are kept between queries and only grow with the graph, so repeated queries don't allocate
+	class NavmeshPathfinder
+	{
+	public:
+		static constexpr std::uint32_t DEFAULT_MAX_EXPANSIONS = 8192;
+
+		// false if either position is off the graph or the goal isn't found within maxExpansions. path is from, the
+		// portals crossed and to
+		bool FindPath(const NavmeshGraph& graph, const glm::vec3& from, const glm::vec3& to, std::vector<glm::vec3>& path,
+			std::uint32_t maxExpansions = DEFAULT_MAX_EXPANSIONS);
+
+	private:
+		struct NodeState
+		{
+			float Cost;
+			std::uint32_t Parent;
+			// the node is untouched unless Stamp is the current query's, closed if ClosedStamp is
+			std::uint32_t Stamp;
+			std::uint32_t ClosedStamp;
+		};
+
+		struct OpenNode
+		{
+			float Estimate;
+			std::uint32_t Node;
+
+			// min heap with the std heap functions
+			bool operator<(const OpenNode& other) const { return Estimate > other.Estimate; }
+		};
+
+		std::vector<NodeState> Nodes;
+		std::vector<OpenNode> Open;
+		std::uint32_t Stamp = 0;
+	};
+
+	// NavmeshPathfinders for running many queries at once, each query borrows one for its duration
+	class NavmeshPathfinderPool
+	{
+	public:
+		struct Query
+		{
+			glm::vec3 From;
+			glm::vec3 To;
+		};
+
+		// paths[i] is empty if query i found no path. paths keeps its capacity between calls
+		void Run(const NavmeshGraph& graph, std::span<const Query> queries, std::vector<std::vector<glm::vec3>>& paths);
+
+	private:
+		NavmeshPathfinder* Acquire();
+		void Release(NavmeshPathfinder* pathfinder);
+
+		std::mutex Mutex;
+		std::vector<std::unique_ptr<NavmeshPathfinder>> Pathfinders;
+		std::vector<NavmeshPathfinder*> Free;
+	};
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// wireframe of one navmesh. Every edge shared by two triangles is only stored once
+	struct NavmeshGeometry
+	{
+		std::vector<glm::vec3> Points;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> Edges;
+		std::vector<std::array<std::uint32_t, 3>> Triangles;
+		// index into Edges of each triangle's edges, in the order (0, 1), (1, 2), (2, 0)
+		std::vector<std::array<std::uint32_t, 3>> TriangleEdges;
+		std::vector<glm::vec3> Centroids;
+
+		// no game world comes close, anything further out is a corrupt vertex
+		static constexpr float MAX_COORDINATE = 1.0e7f;
+		// on X and Y. Real navmesh triangles are far smaller, a larger one would be bucketed into thousands of grid cells
+		static constexpr float MAX_TRIANGLE_SIZE = 16384.0f;
+
+		// false for NaN and infinity as well
+		static bool IsInBounds(const glm::vec3& point)
+		{
+			return std::abs(point.x) <= MAX_COORDINATE && std::abs(point.y) <= MAX_COORDINATE &&
+			       std::abs(point.z) <= MAX_COORDINATE;
+		}
+
+		// triangles referencing vertices out of range, with a vertex out of bounds or larger than MAX_TRIANGLE_SIZE are
+		// skipped
+		void Build(std::vector<glm::vec3> points, const std::vector<std::array<std::uint32_t, 3>>& triangles);
+	};
+
+	// uniform 2D grid over the triangles of all indexed navmeshes, navmeshes are added and removed one at a time as their
+	// cells attach and detach. Triangles are bucketed by their XY bounds, a triangle spanning several grid cells is in
+	// each of them
+	class NavmeshGrid
+	{
+	public:
+		static constexpr float CELL_SIZE = 1024.0f;
+
+		// geometry is expected to come from NavmeshGeometry::Build, so every triangle is in bounds
+		void AddMesh(std::uint32_t key, NavmeshGeometry geometry);
+		void RemoveMesh(std::uint32_t key);
+		bool HasMesh(std::uint32_t key) const { return Slots.contains(key); }
+		std::size_t GetMeshCount() const { return Slots.size(); }
+
+		// function(std::uint32_t key, const NavmeshGeometry&) for every mesh, in no particular order
+		template <class Function>
+		void ForEachMesh(Function&& function) const
+		{
+			for (const auto& [key, slot] : Slots) {
+				function(key, Meshes[slot].Geometry);
+			}
+		}
+
+		// visits every triangle whose bounds are within radius of center, plus its edges and vertices, each exactly once:
+		//   visitor.Triangle(const NavmeshGeometry&, std::uint32_t triangle)
+		//   visitor.Edge(const NavmeshGeometry&, std::uint32_t edge)
+		//   visitor.Point(const NavmeshGeometry&, std::uint32_t point)
+		template <class Visitor>
+		void QueryRadius(const glm::vec3& center, float radius, Visitor& visitor);
+
+	private:
+		struct Mesh
+		{
+			std::uint32_t Key;
+			NavmeshGeometry Geometry;
+			std::vector<std::uint64_t> GridCells;
+
+			// per query stamps, so shared elements are only visited once
+			std::vector<std::uint32_t> TriangleStamps;
+			std::vector<std::uint32_t> EdgeStamps;
+			std::vector<std::uint32_t> PointStamps;
+		};
+
+		struct TriangleRef
+		{
+			std::uint32_t Mesh;
+			std::uint32_t Triangle;
+		};
+
+		static std::int32_t Quantize(float value) { return static_cast<std::int32_t>(std::floor(value / CELL_SIZE)); }
+		static std::uint64_t MakeKey(std::int32_t x, std::int32_t y)
+		{
+			return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+		}
+
+		std::vector<Mesh> Meshes;
+		std::vector<std::uint32_t> FreeMeshes;
+		std::unordered_map<std::uint32_t, std::uint32_t> Slots;
+		std::unordered_map<std::uint64_t, std::vector<TriangleRef>> Grid;
+		std::uint32_t QueryStamp = 0;
+	};
+
+	template <class Visitor>
+	void NavmeshGrid::QueryRadius(const glm::vec3& center, float radius, Visitor& visitor)
+	{
+		if (!NavmeshGeometry::IsInBounds(center) || !(radius >= 0.0f && radius <= NavmeshGeometry::MAX_COORDINATE))
+			return;
+
+		if (++QueryStamp == 0) {
+			// wrapped around, old stamps could collide with the new ones
+			for (auto& mesh : Meshes) {
+				std::fill(mesh.TriangleStamps.begin(), mesh.TriangleStamps.end(), 0);
+				std::fill(mesh.EdgeStamps.begin(), mesh.EdgeStamps.end(), 0);
+				std::fill(mesh.PointStamps.begin(), mesh.PointStamps.end(), 0);
+			}
+			QueryStamp = 1;
+		}
+
+		const float radiusSquared = radius * radius;
+		for (auto x = Quantize(center.x - radius); x <= Quantize(center.x + radius); x++) {
+			for (auto y = Quantize(center.y - radius); y <= Quantize(center.y + radius); y++) {
+				auto cell = Grid.find(MakeKey(x, y));
+				if (cell == Grid.end())
+					continue;
+
+				for (const auto& ref : cell->second) {
+					auto& mesh = Meshes[ref.Mesh];
+					if (mesh.TriangleStamps[ref.Triangle] == QueryStamp)
+						continue;
+					mesh.TriangleStamps[ref.Triangle] = QueryStamp;
+
+					const auto& geometry = mesh.Geometry;
+					const auto& triangle = geometry.Triangles[ref.Triangle];
+					const auto& p0 = geometry.Points[triangle[0]];
+					const auto& p1 = geometry.Points[triangle[1]];
+					const auto& p2 = geometry.Points[triangle[2]];
+					const auto min = glm::min(p0, glm::min(p1, p2));
+					const auto max = glm::max(p0, glm::max(p1, p2));
+					const auto closest = glm::clamp(center, min, max);
+					if (glm::dot(closest - center, closest - center) > radiusSquared)
+						continue;
+
+					visitor.Triangle(geometry, ref.Triangle);
+
+					for (auto edge : geometry.TriangleEdges[ref.Triangle]) {
+						if (mesh.EdgeStamps[edge] != QueryStamp) {
+							mesh.EdgeStamps[edge] = QueryStamp;
+							visitor.Edge(geometry, edge);
+						}
+					}
+
+					for (auto point : triangle) {
+						if (mesh.PointStamps[point] != QueryStamp) {
+							mesh.PointStamps[point] = QueryStamp;
+							visitor.Point(geometry, point);
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace DebugAPI_IMPL
+{
+	// per frame counters and timing histograms of the overlay pipeline. Counting and recording are relaxed atomic
+	// operations, so any thread can do them without locking. EndFrame moves the frame's counts into a rolling window
+	// and must only be called by one thread at a time, the getters can be called from anywhere
+	class PerfCounters
+	{
+	public:
+		enum Counter : std::uint32_t
+		{
+			// commands drained from the submit queue
+			kSubmitted,
+			// commands a full submit queue turned away, see LineSubmitQueue::MAX_PENDING_CHUNKS
+			kDropped,
+			// commands that refreshed an existing line instead of adding one
+			kMerged,
+			// lifetime 0 commands, they skip the line store
+			kTransient,
+			// lines entirely off screen or behind the camera
+			kCulled,
+			// visible, but shorter than FrameBudget::MinScreenLength
+			kTooShort,
+			// visible, but dropped to stay within the FrameBudget
+			kOverBudget,
+			kDrawn,
+			// drawn lines chained by shared endpoints, see DrawList
+			kPolylines,
+			kExpired,
+			// lines in the line store at the end of the frame
+			kLive,
+			// calls into the movie
+			kInvokes,
+			// lines of visible retained batches, see LineRenderer::CreateBatch
+			kBatchLines,
+			// batch lines projected again because their batch or the camera changed
+			kReprojected,
+
+			kCounterCount
+		};
+
+		enum Timer : std::uint32_t
+		{
+			kRenderFrame,
+			// game thread side of the navmesh overlay: waiting for the worker, handing over its lines, syncing the grid
+			kNavmeshSync,
+			// navmesh wireframe built on the worker
+			kNavmeshBuild,
+			// actor path queries on the worker, including graph rebuilds
+			kNavmeshPaths,
+			// skeleton cache upkeep and the skeleton overlay
+			kSkeletons,
+
+			kTimerCount
+		};
+
+		// frames the counter averages are taken over
+		static constexpr std::uint32_t WINDOW_FRAMES = 128;
+		// most recent samples the timer percentiles are taken over
+		static constexpr std::uint32_t HISTOGRAM_SAMPLES = 256;
+
+		void Add(Counter counter, std::uint32_t count = 1) { Frame[counter].fetch_add(count, std::memory_order_relaxed); }
+		void Record(Timer timer, float microseconds);
+		void EndFrame();
+
+		// mean of the counter over the last WINDOW_FRAMES frames
+		float GetAverage(Counter counter) const;
+		// percentile in [0, 1] of the timer's last HISTOGRAM_SAMPLES samples, in microseconds
+		float GetPercentile(Timer timer, float percentile) const;
+
+		// a few short lines for the stats panel and the log
+		std::string Format() const;
+
+	private:
+		std::array<std::atomic<std::uint32_t>, kCounterCount> Frame{};
+
+		// written by EndFrame only
+		std::array<std::array<std::uint32_t, kCounterCount>, WINDOW_FRAMES> History{};
+		std::uint32_t HistoryPos = 0;
+		std::array<std::atomic<std::uint64_t>, kCounterCount> Sums{};
+		std::atomic<std::uint32_t> HistoryCount{ 0 };
+
+		struct Histogram
+		{
+			std::array<std::atomic<float>, HISTOGRAM_SAMPLES> Samples{};
+			std::atomic<std::uint32_t> Count{ 0 };
+		};
+		std::array<Histogram, kTimerCount> Histograms;
+	};
+
+	// records the time between construction and destruction
+	class ScopedPerfTimer
+	{
+	public:
+		ScopedPerfTimer(PerfCounters& counters, PerfCounters::Timer timer) :
+			Counters(counters),
+			Timer(timer),
+			Start(std::chrono::steady_clock::now())
+		{}
+
+		~ScopedPerfTimer()
+		{
+			const auto elapsed = std::chrono::steady_clock::now() - Start;
+			Counters.Record(Timer, std::chrono::duration<float, std::micro>(elapsed).count());
+		}
+
+	private:
+		PerfCounters& Counters;
+		PerfCounters::Timer Timer;
+		std::chrono::steady_clock::time_point Start;
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// everything needed to cull, clip and project world positions onto the overlay movie, captured once per frame
+	// instead of being looked up again for every point
+	struct CameraSnapshot
+	{
+		glm::vec3 Position;
+		// NiCamera world to camera matrix, row major. Row 3 is the clip space w, i.e. the view depth
+		float WorldToCam[4][4];
+		// NiCamera viewport, the port WorldPtToScreenPt3 maps to
+		float PortLeft, PortRight, PortTop, PortBottom;
+		// visible frame rect of the overlay movie
+		float RectLeft, RectRight, RectTop, RectBottom;
+	};
+
+	namespace Projection
+	{
+		static constexpr float ZERO_TOLERANCE = 1e-5f;
+		// segments are clipped against w >= NEAR_PLANE_W, so nothing behind or at the camera is ever divided by
+		static constexpr float NEAR_PLANE_W = 1e-3f;
+
+		// batches smaller than this aren't worth waking up other cores for
+		static constexpr std::size_t PARALLEL_MIN_POINTS = 32768;
+		static constexpr std::size_t PARALLEL_CHUNK_POINTS = 8192;
+
+		// the same math as NiCamera::WorldPtToScreenPt3 followed by the mapping into the movie's frame rect, for points
+		// in front of the camera. A point behind it (w <= ZERO_TOLERANCE) is projected as if it were on the zero
+		// tolerance plane, which is not what the engine returns for it, so DebugAPI::WorldToScreenLoc keeps calling
+		// the engine. Nothing that gets drawn goes through here, segments are clipped against the near plane instead
+		glm::vec2 ProjectPoint(const CameraSnapshot& snapshot, const glm::vec3& point);
+
+		glm::vec4 TransformToClip(const CameraSnapshot& snapshot, const glm::vec3& point);
+		// same result as TransformToClip for every point, 4 points at a time with SSE, large batches are split across cores
+		void TransformToClip(const CameraSnapshot& snapshot, const glm::vec3* points, glm::vec4* out, std::size_t count);
+		// scalar reference for the batch above, one point at a time on the calling thread
+		void TransformToClipScalar(const CameraSnapshot& snapshot, const glm::vec3* points, glm::vec4* out,
+			std::size_t count);
+
+		// homogeneous Cohen-Sutherland against the screen edges and the near plane. Returns false if no part of the
+		// segment is visible, otherwise moves the endpoints onto the visible part
+		bool ClipSegment(glm::vec4& from, glm::vec4& to);
+
+		// perspective divide and mapping into the frame rect of a clip space point that passed ClipSegment
+		glm::vec2 ClipToScreen(const CameraSnapshot& snapshot, const glm::vec4& clip);
+	}
+}
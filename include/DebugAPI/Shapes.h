@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace DebugAPI_IMPL
+{
+	// circles and everything built from them (spheres, capsules, cones) use precomputed unit circle tables, so drawing
+	// one costs a single rotation and a multiply-add per point instead of a matrix and a sin/cos per point
+	namespace Shapes
+	{
+		static constexpr std::uint32_t MIN_CIRCLE_SEGMENTS = 8;
+		static constexpr std::uint32_t MAX_CIRCLE_SEGMENTS = 64;
+		// used when there is no camera to measure the on-screen size against yet
+		static constexpr std::uint32_t DEFAULT_CIRCLE_SEGMENTS = 32;
+		// on-screen length of one segment the segment count is picked for
+		static constexpr float CIRCLE_SEGMENT_PIXELS = 8.0f;
+
+		struct UnitCirclePoint
+		{
+			float Cos;
+			float Sin;
+		};
+
+		namespace detail
+		{
+			inline constexpr double PI = 3.14159265358979323846;
+
+			// std::sin isn't constexpr yet. Range reduction plus a Taylor series is plenty accurate for a table of floats
+			constexpr double Sine(double x)
+			{
+				while (x > PI) {
+					x -= 2.0 * PI;
+				}
+				while (x < -PI) {
+					x += 2.0 * PI;
+				}
+
+				double term = x;
+				double sum = x;
+				for (int i = 1; i < 20; i++) {
+					term *= -x * x / ((2.0 * i) * (2.0 * i + 1.0));
+					sum += term;
+				}
+				return sum;
+			}
+
+			constexpr double Cosine(double x) { return Sine(x + PI * 0.5); }
+
+			template <std::uint32_t Segments>
+			constexpr std::array<UnitCirclePoint, Segments> MakeUnitCircle()
+			{
+				std::array<UnitCirclePoint, Segments> table{};
+				for (std::uint32_t i = 0; i < Segments; i++) {
+					const double angle = 2.0 * PI * i / Segments;
+					table[i] = { static_cast<float>(Cosine(angle)), static_cast<float>(Sine(angle)) };
+				}
+				return table;
+			}
+		}
+
+		inline constexpr auto UNIT_CIRCLE_8 = detail::MakeUnitCircle<8>();
+		inline constexpr auto UNIT_CIRCLE_16 = detail::MakeUnitCircle<16>();
+		inline constexpr auto UNIT_CIRCLE_32 = detail::MakeUnitCircle<32>();
+		inline constexpr auto UNIT_CIRCLE_64 = detail::MakeUnitCircle<64>();
+
+		// segments is rounded up to the next table, i.e. 8, 16, 32 or 64
+		std::span<const UnitCirclePoint> GetUnitCircle(std::uint32_t segments);
+
+		// appends the first count points of a circle around origin in the plane spanned by the unit vectors u and v,
+		// starting at origin + u * radius. count == segments is the full circle, segments / 2 + 1 a half circle
+		void AppendCircle(std::vector<glm::vec3>& out, const glm::vec3& origin, const glm::vec3& u, const glm::vec3& v,
+			float radius, std::uint32_t segments, std::uint32_t count);
+
+		// two unit vectors perpendicular to the normalized axis and to each other
+		void GetBasis(const glm::vec3& axis, glm::vec3& u, glm::vec3& v);
+	}
+}
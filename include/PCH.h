@@ -6,6 +6,7 @@
 #include "SKSE/SKSE.h"
 
 #pragma warning(push)
+#include <spdlog/async.h>
 #ifdef DEBUG
 #	include <spdlog/sinks/basic_file_sink.h>
 #else
@@ -0,0 +1,36 @@
+// the movie of DebugOverlayMenu (src/main.cpp). The plugin draws on _root with the MovieClip drawing API, either one
+// Invoke per lineStyle/moveTo/lineTo or a whole frame at once through drawPolylines, see DrawList::Submit.
+//
+// compiled into Data/Interface/CreationKitInSkyrim/overlay_menu.swf with
+//   mtasc -version 8 -header 1280:720:60 -main -swf overlay_menu.swf OverlayMenu.as
+class OverlayMenu
+{
+	static function main(root:MovieClip):Void
+	{
+		root.drawPolylines = function(packed:Array):Void {
+			OverlayMenu.drawPolylines(this, packed);
+		};
+	}
+
+	// packed is
+	//   [groupCount, { thickness, color, alpha, polylineCount, { pointCount, { x, y } * pointCount } * polylineCount }
+	//   * groupCount]
+	static function drawPolylines(target:MovieClip, packed:Array):Void
+	{
+		var i:Number = 0;
+		var groupCount:Number = packed[i++];
+		for (var group:Number = 0; group < groupCount; group++) {
+			target.lineStyle(packed[i], packed[i + 1], packed[i + 2]);
+			var polylineCount:Number = packed[i + 3];
+			i += 4;
+
+			for (var polyline:Number = 0; polyline < polylineCount; polyline++) {
+				var end:Number = i + 1 + packed[i] * 2;
+				target.moveTo(packed[i + 1], packed[i + 2]);
+				for (i += 3; i < end; i += 2) {
+					target.lineTo(packed[i], packed[i + 1]);
+				}
+			}
+		}
+	}
+}
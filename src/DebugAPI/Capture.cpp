@@ -0,0 +1,70 @@
+#include "DebugAPI/Capture.h"
+
+#include <algorithm>
+
+namespace DebugAPI_IMPL
+{
+	namespace Capture
+	{
+		template <class T>
+		static void Write(std::ofstream& stream, const T& value)
+		{
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template <class T>
+		static bool Read(std::ifstream& stream, T& value)
+		{
+			return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+	}
+
+	bool Capture::Writer::Open(const std::filesystem::path& path)
+	{
+		Stream.open(path, std::ios::binary | std::ios::trunc);
+		if (!Stream)
+			return false;
+
+		Write(Stream, MAGIC);
+		Write(Stream, VERSION);
+		return true;
+	}
+
+	void Capture::Writer::WriteFrame(std::uint64_t now, const CameraSnapshot& camera, std::span<const LineCommand> commands)
+	{
+		Write(Stream, now);
+		Write(Stream, camera);
+		Write(Stream, static_cast<std::uint32_t>(commands.size()));
+		Stream.write(reinterpret_cast<const char*>(commands.data()), commands.size_bytes());
+
+		// the game doesn't always shut down cleanly, so don't keep frames in the stream buffer
+		Stream.flush();
+	}
+
+	bool Capture::Reader::Open(const std::filesystem::path& path)
+	{
+		Stream.open(path, std::ios::binary | std::ios::ate);
+		Size = static_cast<std::uint64_t>(std::max<std::streamoff>(Stream.tellg(), 0));
+		Stream.seekg(0);
+
+		std::uint32_t magic = 0;
+		std::uint32_t version = 0;
+		return Read(Stream, magic) && Read(Stream, version) && magic == MAGIC && version == VERSION;
+	}
+
+	bool Capture::Reader::ReadFrame(Frame& frame)
+	{
+		std::uint32_t commandCount = 0;
+		if (!Read(Stream, frame.Now) || !Read(Stream, frame.Camera) || !Read(Stream, commandCount))
+			return false;
+
+		// checked before resizing, a corrupt count would otherwise allocate up to 160GB
+		const auto remaining = Size - static_cast<std::uint64_t>(Stream.tellg());
+		if (commandCount > remaining / sizeof(LineCommand))
+			return false;
+
+		frame.Commands.resize(commandCount);
+		return static_cast<bool>(
+			Stream.read(reinterpret_cast<char*>(frame.Commands.data()), commandCount * sizeof(LineCommand)));
+	}
+}
@@ -0,0 +1,179 @@
+#include "DebugAPI/DrawList.h"
+
+#include <bit>
+#include <cmath>
+
+namespace DebugAPI_IMPL
+{
+	void DrawList::Clear()
+	{
+		for (std::uint32_t i = 0; i < GroupCount; i++) {
+			Groups[i].Segments.clear();
+		}
+
+		GroupCount = 0;
+		LastGroup = 0;
+		LineCount = 0;
+	}
+
+	void DrawList::AddLine(const glm::vec2& from, const glm::vec2& to, float color, float lineThickness, float alpha)
+	{
+		auto matches = [&](const StyleGroup& group) {
+			return group.Thickness == lineThickness && group.Color == color && group.Alpha == alpha;
+		};
+
+		// consecutive lines usually share a style, and there are only a handful of styles per frame
+		if (LastGroup >= GroupCount || !matches(Groups[LastGroup])) {
+			LastGroup = 0;
+			while (LastGroup < GroupCount && !matches(Groups[LastGroup])) {
+				LastGroup++;
+			}
+
+			if (LastGroup == GroupCount) {
+				if (GroupCount == Groups.size()) {
+					Groups.emplace_back();
+				}
+
+				auto& group = Groups[GroupCount++];
+				group.Thickness = lineThickness;
+				group.Color = color;
+				group.Alpha = alpha;
+			}
+		}
+
+		Groups[LastGroup].Segments.emplace_back(from.x, from.y, to.x, to.y);
+		LineCount++;
+	}
+
+	void DrawList::BuildPolylines(StyleGroup& group)
+	{
+		group.Points.clear();
+		group.PolylineSizes.clear();
+
+		const auto segmentCount = static_cast<std::uint32_t>(group.Segments.size());
+		const auto endpointCount = segmentCount * 2;
+
+		auto getPoint = [&](std::uint32_t endpoint) {
+			const auto& segment = group.Segments[endpoint / 2];
+			return endpoint % 2 ? glm::vec2(segment.z, segment.w) : glm::vec2(segment.x, segment.y);
+		};
+
+		// at most half full
+		const auto bucketCount = std::bit_ceil(endpointCount * 2);
+		const auto bucketMask = bucketCount - 1;
+		BucketKeys.resize(bucketCount);
+		BucketHeads.assign(bucketCount, INVALID_INDEX);
+		EndpointBucket.resize(endpointCount);
+		EndpointNext.resize(endpointCount);
+
+		for (std::uint32_t endpoint = 0; endpoint < endpointCount; endpoint++) {
+			const auto point = getPoint(endpoint);
+			const auto x = static_cast<std::uint32_t>(std::lround(point.x * POINT_GRID));
+			const auto y = static_cast<std::uint32_t>(std::lround(point.y * POINT_GRID));
+			const auto key = static_cast<std::uint64_t>(x) << 32 | y;
+
+			auto bucket = static_cast<std::uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & bucketMask;
+			while (BucketHeads[bucket] != INVALID_INDEX && BucketKeys[bucket] != key) {
+				bucket = (bucket + 1) & bucketMask;
+			}
+
+			BucketKeys[bucket] = key;
+			EndpointNext[endpoint] = BucketHeads[bucket];
+			BucketHeads[bucket] = endpoint;
+			EndpointBucket[endpoint] = bucket;
+		}
+
+		SegmentUsed.assign(segmentCount, 0);
+
+		// used segments are unlinked from the front of a bucket's list on the way, so each is skipped at most once
+		auto takeConnected = [&](std::uint32_t endpoint) {
+			auto& head = BucketHeads[EndpointBucket[endpoint]];
+			while (head != INVALID_INDEX && SegmentUsed[head / 2]) {
+				head = EndpointNext[head];
+			}
+
+			if (head != INVALID_INDEX) {
+				SegmentUsed[head / 2] = 1;
+			}
+			return head;
+		};
+
+		for (std::uint32_t segment = 0; segment < segmentCount; segment++) {
+			if (SegmentUsed[segment])
+				continue;
+
+			SegmentUsed[segment] = 1;
+
+			BackwardPoints.clear();
+			for (auto end = takeConnected(segment * 2); end != INVALID_INDEX; end = takeConnected(end ^ 1)) {
+				BackwardPoints.push_back(getPoint(end ^ 1));
+			}
+
+			const auto first = group.Points.size();
+			group.Points.insert(group.Points.end(), BackwardPoints.rbegin(), BackwardPoints.rend());
+			group.Points.push_back(getPoint(segment * 2));
+			group.Points.push_back(getPoint(segment * 2 + 1));
+
+			for (auto end = takeConnected(segment * 2 + 1); end != INVALID_INDEX; end = takeConnected(end ^ 1)) {
+				group.Points.push_back(getPoint(end ^ 1));
+			}
+
+			group.PolylineSizes.push_back(static_cast<std::uint32_t>(group.Points.size() - first));
+		}
+	}
+
+	void DrawList::Submit(OverlayMovie& movie)
+	{
+		PolylineCount = 0;
+		if (!LineCount)
+			return;
+
+		std::size_t pointCount = 0;
+		for (std::uint32_t i = 0; i < GroupCount; i++) {
+			BuildPolylines(Groups[i]);
+			PolylineCount += static_cast<std::uint32_t>(Groups[i].PolylineSizes.size());
+			pointCount += Groups[i].Points.size();
+		}
+
+		if (movie.SupportsDrawList()) {
+			Packed.clear();
+			Packed.reserve(1 + GroupCount * 4 + PolylineCount + pointCount * 2);
+			Packed.push_back(static_cast<float>(GroupCount));
+
+			for (std::uint32_t i = 0; i < GroupCount; i++) {
+				const auto& group = Groups[i];
+				Packed.push_back(group.Thickness);
+				Packed.push_back(group.Color);
+				Packed.push_back(group.Alpha);
+				Packed.push_back(static_cast<float>(group.PolylineSizes.size()));
+
+				auto point = group.Points.begin();
+				for (auto size : group.PolylineSizes) {
+					Packed.push_back(static_cast<float>(size));
+					for (auto end = point + size; point != end; ++point) {
+						Packed.insert(Packed.end(), { point->x, point->y });
+					}
+				}
+			}
+
+			movie.InvokeDrawList(Packed);
+			return;
+		}
+
+		for (std::uint32_t i = 0; i < GroupCount; i++) {
+			const auto& group = Groups[i];
+
+			const float style[OverlayMovie::MAX_INVOKE_ARGS]{ group.Thickness, group.Color, group.Alpha };
+			movie.Invoke("lineStyle", style, OverlayMovie::MAX_INVOKE_ARGS);
+
+			const auto* point = group.Points.data();
+			for (auto size : group.PolylineSizes) {
+				movie.Invoke("moveTo", &point->x, 2);
+				for (std::uint32_t j = 1; j < size; j++) {
+					movie.Invoke("lineTo", &point[j].x, 2);
+				}
+				point += size;
+			}
+		}
+	}
+}
@@ -0,0 +1,350 @@
+#include "DebugAPI/LineRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace DebugAPI_IMPL
+{
+	LineRenderer::LineRenderer(float maxDif) :
+		LinesToDraw(maxDif)
+	{}
+
+	std::uint32_t LineRenderer::GetExistingLine(const glm::vec3& from, const glm::vec3& to, std::uint32_t color,
+		float lineThickness)
+	{
+		return LinesToDraw.Find(from, to, color, lineThickness);
+	}
+
+	bool LineRenderer::ApplyCommand(const LineCommand& command)
+	{
+		std::uint32_t oldLine = GetExistingLine(command.From, command.To, command.Color, command.Thickness);
+		if (oldLine != LineStore::INVALID_INDEX) {
+			LinesToDraw.Refresh(oldLine, command.From, command.To, command.Thickness, command.DestroyTickCount);
+			return true;
+		}
+
+		LinesToDraw.Add(command.From, command.To, command.Color, command.Thickness, command.DestroyTickCount);
+		return false;
+	}
+
+	void LineRenderer::SetBudget(const FrameBudget& budget)
+	{
+		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
+		Budget = budget;
+	}
+
+	std::size_t LineRenderer::GetLineCap(float elapsedMicroseconds) const
+	{
+		std::size_t cap = Budget.MaxLines ? Budget.MaxLines : std::numeric_limits<std::size_t>::max();
+
+		if (Budget.MaxMicroseconds && LineCostMicroseconds > 0.0f) {
+			const float remaining = std::max(0.0f, Budget.MaxMicroseconds - elapsedMicroseconds);
+			cap = std::min(cap, std::max(MIN_BUDGET_LINES, static_cast<std::size_t>(remaining / LineCostMicroseconds)));
+		}
+
+		return cap;
+	}
+
+	LineRenderer::BatchHandle LineRenderer::CreateBatch(std::span<const BatchLine> lines, const glm::mat4& transform)
+	{
+		Batch batch;
+		batch.Lines.assign(lines.begin(), lines.end());
+		batch.Transform = transform;
+
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+		const auto handle = NextBatch;
+		if (++NextBatch == INVALID_BATCH) {
+			NextBatch++;
+		}
+
+		Batches.emplace(handle, std::move(batch));
+		return handle;
+	}
+
+	bool LineRenderer::SetBatchTransform(BatchHandle batch, const glm::mat4& transform)
+	{
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+		auto it = Batches.find(batch);
+		if (it == Batches.end())
+			return false;
+
+		it->second.Transform = transform;
+		it->second.Moved = true;
+		return true;
+	}
+
+	bool LineRenderer::SetBatchVisible(BatchHandle batch, bool visible)
+	{
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+		auto it = Batches.find(batch);
+		if (it == Batches.end())
+			return false;
+
+		// hidden batches aren't projected, so one shown again can't tell whether the camera moved meanwhile
+		if (visible && !it->second.Visible) {
+			it->second.Changed = true;
+		}
+		it->second.Visible = visible;
+		return true;
+	}
+
+	bool LineRenderer::SetBatchColor(BatchHandle batch, std::optional<std::uint32_t> color)
+	{
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+		auto it = Batches.find(batch);
+		if (it == Batches.end())
+			return false;
+
+		it->second.Color = color;
+		it->second.Changed = true;
+		return true;
+	}
+
+	bool LineRenderer::DestroyBatch(BatchHandle batch)
+	{
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+		return Batches.erase(batch) != 0;
+	}
+
+	std::uint32_t LineRenderer::GetBatchCount()
+	{
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+		return static_cast<std::uint32_t>(Batches.size());
+	}
+
+	LineRenderer::Visibility LineRenderer::AddCandidate(const CameraSnapshot& camera, glm::vec4 clipFrom, glm::vec4 clipTo,
+		std::uint32_t color, float thickness, std::vector<Candidate>& candidates) const
+	{
+		if (!Projection::ClipSegment(clipFrom, clipTo))
+			return Visibility::kCulled;
+
+		const auto from = Projection::ClipToScreen(camera, clipFrom);
+		const auto to = Projection::ClipToScreen(camera, clipTo);
+		const float length = glm::length(to - from);
+		if (length < Budget.MinScreenLength)
+			return Visibility::kTooShort;
+
+		// w is the view depth
+		const float depth = 0.5f * (clipFrom.w + clipTo.w);
+		candidates.push_back({ from, to, color, thickness, length / (1.0f + depth / PRIORITY_HALF_DISTANCE) });
+		return Visibility::kVisible;
+	}
+
+	void LineRenderer::AddBatches(const CameraSnapshot& camera, std::uint32_t& culled, std::uint32_t& tooShort)
+	{
+		std::lock_guard<std::mutex> lg(Batches_mutex);
+
+		// the snapshot is plain floats, a moved camera differs in at least one of them
+		const bool cameraChanged = std::memcmp(&camera, &BatchCamera, sizeof(CameraSnapshot)) != 0 ||
+		                           Budget.MinScreenLength != BatchMinScreenLength;
+		BatchCamera = camera;
+		BatchMinScreenLength = Budget.MinScreenLength;
+
+		std::uint32_t lines = 0;
+		std::uint32_t reprojected = 0;
+		for (auto& [handle, batch] : Batches) {
+			if (!batch.Visible)
+				continue;
+
+			if (batch.Moved) {
+				batch.Points.clear();
+				for (const auto& line : batch.Lines) {
+					batch.Points.push_back(glm::vec3(batch.Transform * glm::vec4(line.From, 1.0f)));
+					batch.Points.push_back(glm::vec3(batch.Transform * glm::vec4(line.To, 1.0f)));
+				}
+				batch.Moved = false;
+				batch.Changed = true;
+			}
+
+			if (batch.Changed || cameraChanged) {
+				BatchClipPoints.resize(batch.Points.size());
+				Projection::TransformToClip(camera, batch.Points.data(), BatchClipPoints.data(), batch.Points.size());
+
+				batch.Candidates.clear();
+				batch.Culled = 0;
+				batch.TooShort = 0;
+				for (std::size_t i = 0; i < batch.Lines.size(); i++) {
+					const auto& line = batch.Lines[i];
+					const auto visibility = AddCandidate(camera, BatchClipPoints[i * 2], BatchClipPoints[i * 2 + 1],
+						batch.Color.value_or(line.Color), line.Thickness, batch.Candidates);
+					batch.Culled += visibility == Visibility::kCulled;
+					batch.TooShort += visibility == Visibility::kTooShort;
+				}
+
+				batch.Changed = false;
+				reprojected += static_cast<std::uint32_t>(batch.Lines.size());
+			}
+
+			FrameCandidates.insert(FrameCandidates.end(), batch.Candidates.begin(), batch.Candidates.end());
+			culled += batch.Culled;
+			tooShort += batch.TooShort;
+			lines += static_cast<std::uint32_t>(batch.Lines.size());
+		}
+
+		Counters.Add(PerfCounters::kBatchLines, lines);
+		Counters.Add(PerfCounters::kReprojected, reprojected);
+	}
+
+	bool LineRenderer::StartCapture(const std::filesystem::path& path)
+	{
+		auto writer = std::make_unique<Capture::Writer>();
+		if (!writer->Open(path))
+			return false;
+
+		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
+		CaptureWriter = std::move(writer);
+		return true;
+	}
+
+	void LineRenderer::StopCapture()
+	{
+		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
+		CaptureWriter.reset();
+	}
+
+	void LineRenderer::SkipFrame(std::uint64_t now)
+	{
+		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
+
+		// transient lines would be replaced by the next frame's anyway
+		SubmitQueue.Drain([&](const LineCommand& command) {
+			if (command.DestroyTickCount != LineCommand::TRANSIENT) {
+				ApplyCommand(command);
+			}
+		});
+
+		TransientLines.Reset();
+		LinesToDraw.Expire(now);
+	}
+
+	void LineRenderer::RenderFrame(const CameraSnapshot& camera, std::uint64_t now, OverlayMovie& movie)
+	{
+		ScopedPerfTimer timer(Counters, PerfCounters::kRenderFrame);
+		const auto frameStart = std::chrono::steady_clock::now();
+
+		movie.Invoke("clear", nullptr, 0);
+
+		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
+
+		// counted locally and added once, so counting doesn't cost an atomic per line
+		std::uint32_t submitted = 0;
+		std::uint32_t merged = 0;
+		std::uint32_t transient = 0;
+		std::uint32_t culled = 0;
+		std::uint32_t tooShort = 0;
+		std::uint32_t overBudget = 0;
+
+		// everything submitted since the last frame, producers keep pushing into fresh chunks meanwhile. The first new
+		// transient line replaces the previous frame's ones
+		bool newTransients = false;
+		SubmitQueue.Drain([&](const LineCommand& command) {
+			submitted++;
+			if (CaptureWriter) {
+				CaptureCommands.push_back(command);
+			}
+
+			if (command.DestroyTickCount != LineCommand::TRANSIENT) {
+				merged += ApplyCommand(command);
+				return;
+			}
+
+			transient++;
+			if (!newTransients) {
+				TransientLines.Reset();
+				newTransients = true;
+			}
+			TransientLines.Append(command);
+		});
+
+		if (newTransients) {
+			TransientTickCount = now;
+		}
+
+		if (CaptureWriter) {
+			CaptureWriter->WriteFrame(now, camera, CaptureCommands);
+			CaptureCommands.clear();
+		}
+
+		FramePoints.clear();
+		for (std::uint32_t i = 0; i < LinesToDraw.Size(); i++) {
+			FramePoints.push_back(LinesToDraw[i].From);
+			FramePoints.push_back(LinesToDraw[i].To);
+		}
+		for (std::uint32_t i = 0; i < TransientLines.Size(); i++) {
+			FramePoints.push_back(TransientLines[i].From);
+			FramePoints.push_back(TransientLines[i].To);
+		}
+
+		FrameClipPoints.resize(FramePoints.size());
+		Projection::TransformToClip(camera, FramePoints.data(), FrameClipPoints.data(), FramePoints.size());
+
+		FrameCandidates.clear();
+		auto addLine = [&](std::size_t point, std::uint32_t color, float thickness) {
+			const auto visibility =
+				AddCandidate(camera, FrameClipPoints[point], FrameClipPoints[point + 1], color, thickness, FrameCandidates);
+			culled += visibility == Visibility::kCulled;
+			tooShort += visibility == Visibility::kTooShort;
+		};
+
+		for (std::uint32_t i = 0; i < LinesToDraw.Size(); i++) {
+			addLine(i * 2, LinesToDraw[i].Color, LinesToDraw[i].GetThickness());
+		}
+
+		const std::size_t transientOffset = LinesToDraw.Size() * 2;
+		for (std::uint32_t i = 0; i < TransientLines.Size(); i++) {
+			addLine(transientOffset + i * 2, TransientLines[i].Color, TransientLines[i].Thickness);
+		}
+
+		AddBatches(camera, culled, tooShort);
+
+		const auto drawStart = std::chrono::steady_clock::now();
+
+		const auto cap = GetLineCap(std::chrono::duration<float, std::micro>(drawStart - frameStart).count());
+		if (FrameCandidates.size() > cap) {
+			overBudget = static_cast<std::uint32_t>(FrameCandidates.size() - cap);
+			std::nth_element(FrameCandidates.begin(), FrameCandidates.begin() + cap, FrameCandidates.end(),
+				[](const Candidate& a, const Candidate& b) { return a.Priority > b.Priority; });
+			FrameCandidates.resize(cap);
+		}
+
+		FrameDrawList.Clear();
+		for (const auto& candidate : FrameCandidates) {
+			FrameDrawList.AddLine(candidate.From, candidate.To, DebugAPILine::GetHexColor(candidate.Color),
+				candidate.Thickness, DebugAPILine::GetAlpha(candidate.Color));
+		}
+
+		FrameDrawList.Submit(movie);
+
+		const auto drawnCount = FrameDrawList.GetLineCount();
+		if (drawnCount >= MIN_LINE_COST_SAMPLES) {
+			const auto drawTime = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - drawStart);
+			const float cost = drawTime.count() / drawnCount;
+			LineCostMicroseconds = LineCostMicroseconds > 0.0f ? std::lerp(LineCostMicroseconds, cost, 0.1f) : cost;
+		}
+
+		// lines are drawn one last time in the frame they expire in, transient lines act as if they had a lifetime of 0
+		const auto liveBefore = LinesToDraw.Size();
+		LinesToDraw.Expire(now);
+
+		if (now > TransientTickCount) {
+			TransientLines.Reset();
+		}
+
+		Counters.Add(PerfCounters::kSubmitted, submitted);
+		Counters.Add(PerfCounters::kDropped, SubmitQueue.TakeDroppedCount());
+		Counters.Add(PerfCounters::kMerged, merged);
+		Counters.Add(PerfCounters::kTransient, transient);
+		Counters.Add(PerfCounters::kCulled, culled);
+		Counters.Add(PerfCounters::kTooShort, tooShort);
+		Counters.Add(PerfCounters::kOverBudget, overBudget);
+		Counters.Add(PerfCounters::kDrawn, FrameDrawList.GetLineCount());
+		Counters.Add(PerfCounters::kPolylines, FrameDrawList.GetPolylineCount());
+		Counters.Add(PerfCounters::kExpired, liveBefore - LinesToDraw.Size());
+		Counters.Add(PerfCounters::kLive, LinesToDraw.Size());
+		Counters.Add(PerfCounters::kInvokes, movie.InvokeCount);
+		Counters.EndFrame();
+	}
+}
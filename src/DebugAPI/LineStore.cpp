@@ -0,0 +1,254 @@
+#include "DebugAPI/LineStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "DebugAPI/Math.h"
+
+namespace DebugAPI_IMPL
+{
+	std::uint32_t DebugAPILine::PackColor(const glm::vec4& color)
+	{
+		auto component = [](float value) {
+			return static_cast<std::uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		};
+
+		return (component(color.r) << 24) | (component(color.g) << 16) | (component(color.b) << 8) | component(color.a);
+	}
+
+	std::uint16_t DebugAPILine::PackThickness(float lineThickness)
+	{
+		return static_cast<std::uint16_t>(std::clamp(lineThickness * 16.0f + 0.5f, 0.0f, 65535.0f));
+	}
+
+	LineStore::LineStore(float maxDif) :
+		MaxDif(maxDif)
+	{
+		Rehash(1024);
+		WheelHeads.fill(INVALID_INDEX);
+	}
+
+	std::int32_t LineStore::Quantize(float value) const { return static_cast<std::int32_t>(std::floor(value / MaxDif)); }
+
+	std::uint64_t LineStore::MakeKey(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t color)
+	{
+		// FNV-1a over the cell coordinates and color. Collisions only cost an extra comparison in Find,
+		// because every candidate is checked against the full leniency test anyway
+		std::uint64_t hash = 14695981039346656037ull;
+		auto mix = [&hash](std::uint32_t value) {
+			hash ^= value;
+			hash *= 1099511628211ull;
+		};
+
+		mix(static_cast<std::uint32_t>(x));
+		mix(static_cast<std::uint32_t>(y));
+		mix(static_cast<std::uint32_t>(z));
+		mix(color);
+
+		return hash;
+	}
+
+	std::uint64_t LineStore::GetKey(const DebugAPILine& line) const
+	{
+		return MakeKey(Quantize(line.From.x), Quantize(line.From.y), Quantize(line.From.z), line.Color);
+	}
+
+	void LineStore::Link(std::uint32_t index)
+	{
+		auto& head = GetHead(GetKey(Lines[index]));
+		Lines[index].NextInBucket = head;
+		head = index;
+	}
+
+	void LineStore::Unlink(std::uint32_t index)
+	{
+		std::uint32_t* link = &GetHead(GetKey(Lines[index]));
+		while (*link != INVALID_INDEX) {
+			if (*link == index) {
+				*link = Lines[index].NextInBucket;
+				return;
+			}
+			link = &Lines[*link].NextInBucket;
+		}
+	}
+
+	void LineStore::Schedule(std::uint32_t index)
+	{
+		auto& line = Lines[index];
+
+		// anything already due goes into the slot Expire visits next
+		const auto slotTime = std::max(line.DestroyTickCount / WHEEL_SLOT_MS, WheelTime);
+		line.WheelSlot = static_cast<std::uint16_t>(slotTime % WHEEL_SLOTS);
+
+		auto& head = WheelHeads[line.WheelSlot];
+		line.WheelPrev = INVALID_INDEX;
+		line.WheelNext = head;
+		if (head != INVALID_INDEX) {
+			Lines[head].WheelPrev = index;
+		}
+		head = index;
+	}
+
+	void LineStore::Unschedule(std::uint32_t index)
+	{
+		const auto& line = Lines[index];
+
+		if (line.WheelPrev != INVALID_INDEX) {
+			Lines[line.WheelPrev].WheelNext = line.WheelNext;
+		} else {
+			WheelHeads[line.WheelSlot] = line.WheelNext;
+		}
+
+		if (line.WheelNext != INVALID_INDEX) {
+			Lines[line.WheelNext].WheelPrev = line.WheelPrev;
+		}
+	}
+
+	void LineStore::Expire(std::uint64_t now)
+	{
+		const auto nowTime = now / WHEEL_SLOT_MS;
+		if (Lines.empty()) {
+			WheelTime = nowTime;
+			return;
+		}
+
+		// after a long stall every slot is due once, no need to go around more than one revolution
+		const auto firstTime = std::max(WheelTime, nowTime >= WHEEL_SLOTS ? nowTime - (WHEEL_SLOTS - 1) : 0);
+
+		Expired.clear();
+		for (auto time = firstTime; time <= nowTime; time++) {
+			for (auto i = WheelHeads[time % WHEEL_SLOTS]; i != INVALID_INDEX; i = Lines[i].WheelNext) {
+				if (now > Lines[i].DestroyTickCount) {
+					Expired.push_back(i);
+				}
+			}
+		}
+
+		WheelTime = nowTime;
+
+		// highest index first, so swap-and-pop never moves a line that is still waiting to be removed
+		std::sort(Expired.begin(), Expired.end(), std::greater<>());
+		for (auto i : Expired) {
+			Remove(i);
+		}
+	}
+
+	void LineStore::Rehash(std::size_t headCount)
+	{
+		Heads.assign(headCount, INVALID_INDEX);
+		for (std::uint32_t i = 0; i < Lines.size(); i++) {
+			Link(i);
+		}
+	}
+
+	std::uint32_t LineStore::Add(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float lineThickness,
+		std::uint64_t destroyTickCount)
+	{
+		// keep the load factor at or below 1/2, chains stay short and Find stays O(1)
+		if ((Lines.size() + 1) * 2 > Heads.size()) {
+			Rehash(Heads.size() * 2);
+		}
+
+		DebugAPILine line;
+		line.From = from;
+		line.To = to;
+		line.Color = color;
+		line.Thickness = DebugAPILine::PackThickness(lineThickness);
+		line.Sequence = NextSequence++;
+		line.DestroyTickCount = destroyTickCount;
+
+		const auto index = static_cast<std::uint32_t>(Lines.size());
+		Lines.push_back(line);
+		Link(index);
+		Schedule(index);
+
+		return index;
+	}
+
+	void LineStore::Refresh(std::uint32_t index, const glm::vec3& from, const glm::vec3& to, float lineThickness,
+		std::uint64_t destroyTickCount)
+	{
+		// the start point may move to a different cell, so it has to be re-linked
+		Unlink(index);
+
+		auto& line = Lines[index];
+		line.From = from;
+		line.To = to;
+		line.Thickness = DebugAPILine::PackThickness(lineThickness);
+
+		if (line.DestroyTickCount != destroyTickCount) {
+			Unschedule(index);
+			line.DestroyTickCount = destroyTickCount;
+			Schedule(index);
+		}
+
+		Link(index);
+	}
+
+	void LineStore::Remove(std::uint32_t index)
+	{
+		Unlink(index);
+		Unschedule(index);
+
+		const auto last = static_cast<std::uint32_t>(Lines.size() - 1);
+		if (index != last) {
+			// the bucket chain and wheel slot of the moved line still point at its old slot
+			Unlink(last);
+			Unschedule(last);
+			Lines[index] = Lines[last];
+			Link(index);
+			Schedule(index);
+		}
+
+		Lines.pop_back();
+	}
+
+	void LineStore::Clear()
+	{
+		Lines.clear();
+		std::fill(Heads.begin(), Heads.end(), INVALID_INDEX);
+		WheelHeads.fill(INVALID_INDEX);
+		NextSequence = 0;
+	}
+
+	std::uint32_t LineStore::Find(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float lineThickness) const
+	{
+		if (Lines.empty())
+			return INVALID_INDEX;
+
+		// quantizing the bounds instead of the point itself keeps this exact at cell borders. IsRoughlyEqual rounds its
+		// difference, so a line a hair further than MaxDif away still matches: the bounds get a few ulps of slack, which
+		// only ever adds a row of cells when the point is right at a border
+		auto range = [this](float value) {
+			const float slack = MaxDif + (std::abs(value) + MaxDif) * (8.0f * std::numeric_limits<float>::epsilon());
+			return std::pair(Quantize(value - slack), Quantize(value + slack));
+		};
+		const auto [minX, maxX] = range(from.x);
+		const auto [minY, maxY] = range(from.y);
+		const auto [minZ, maxZ] = range(from.z);
+
+		std::uint32_t best = INVALID_INDEX;
+		for (std::int32_t x = minX; x <= maxX; x++) {
+			for (std::int32_t y = minY; y <= maxY; y++) {
+				for (std::int32_t z = minZ; z <= maxZ; z++) {
+					for (auto i = GetHead(MakeKey(x, y, z, color)); i != INVALID_INDEX; i = Lines[i].NextInBucket) {
+						const DebugAPILine& line = Lines[i];
+						if (best != INVALID_INDEX && line.Sequence > Lines[best].Sequence)
+							continue;
+
+						if (IsRoughlyEqual(from.x, line.From.x, MaxDif) && IsRoughlyEqual(from.y, line.From.y, MaxDif) &&
+							IsRoughlyEqual(from.z, line.From.z, MaxDif) && IsRoughlyEqual(to.x, line.To.x, MaxDif) &&
+							IsRoughlyEqual(to.y, line.To.y, MaxDif) && IsRoughlyEqual(to.z, line.To.z, MaxDif) &&
+							IsRoughlyEqual(lineThickness, line.GetThickness(), MaxDif) && color == line.Color) {
+							best = i;
+						}
+					}
+				}
+			}
+		}
+
+		return best;
+	}
+}
@@ -0,0 +1,192 @@
+#include "DebugAPI/LineSubmitQueue.h"
+
+#include <algorithm>
+
+namespace DebugAPI_IMPL
+{
+	LineSubmitQueue::~LineSubmitQueue()
+	{
+		for (auto queue = Queues.load(std::memory_order_acquire); queue;) {
+			auto next = queue->NextQueue;
+			if (queue->References.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				ReleaseProducerQueue(queue);
+			}
+			queue = next;
+		}
+	}
+
+	std::uint32_t LineSubmitQueue::GetProducerCount() const
+	{
+		std::uint32_t count = 0;
+		for (auto queue = Queues.load(std::memory_order_acquire); queue; queue = queue->NextQueue) {
+			count++;
+		}
+		return count;
+	}
+
+	LineSubmitQueue::ThreadQueues::~ThreadQueues()
+	{
+		for (auto queue : Queues) {
+			// cleared before letting go, the LineSubmitQueue's reference keeps the queue alive for a claiming thread
+			queue->Claimed.store(false, std::memory_order_release);
+			if (queue->References.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				ReleaseProducerQueue(queue);
+			}
+		}
+	}
+
+	LineSubmitQueue::ProducerQueue* LineSubmitQueue::ThreadQueues::Find(std::uint64_t owner) const
+	{
+		auto it = std::ranges::find(Queues, owner, &ProducerQueue::Owner);
+		return it != Queues.end() ? *it : nullptr;
+	}
+
+	void LineSubmitQueue::ThreadQueues::Add(ProducerQueue* queue)
+	{
+		std::erase_if(Queues, [](ProducerQueue* queue) {
+			if (queue->References.load(std::memory_order_acquire) != 1)
+				return false;
+
+			ReleaseProducerQueue(queue);
+			return true;
+		});
+
+		Queues.push_back(queue);
+	}
+
+	void LineSubmitQueue::ReleaseProducerQueue(ProducerQueue* queue)
+	{
+		// everything from Head on is still linked, consumed chunks before it are on the free list
+		for (Chunk* chunk = queue->Head; chunk;) {
+			Chunk* next = chunk->Next.load(std::memory_order_relaxed);
+			delete chunk;
+			chunk = next;
+		}
+
+		for (Chunk* chunk = queue->FreeChunks.load(std::memory_order_relaxed); chunk;) {
+			Chunk* next = chunk->NextFree;
+			delete chunk;
+			chunk = next;
+		}
+
+		delete queue;
+	}
+
+	LineSubmitQueue::ProducerQueue* LineSubmitQueue::ClaimProducerQueue()
+	{
+		for (auto queue = Queues.load(std::memory_order_acquire); queue; queue = queue->NextQueue) {
+			bool claimed = false;
+			if (!queue->Claimed.load(std::memory_order_relaxed) &&
+				queue->Claimed.compare_exchange_strong(claimed, true, std::memory_order_acquire)) {
+				queue->References.fetch_add(1, std::memory_order_relaxed);
+				return queue;
+			}
+		}
+
+		return nullptr;
+	}
+
+	LineSubmitQueue::ProducerQueue& LineSubmitQueue::GetProducerQueue()
+	{
+		thread_local ThreadQueues threadQueues;
+		// keyed on Id rather than this, a queue created at the address of a destroyed one must not get its producers
+		thread_local std::uint64_t owner = 0;
+		thread_local ProducerQueue* local = nullptr;
+
+		if (owner == Id)
+			return *local;
+
+		// this thread pushed to another queue in between
+		auto queue = threadQueues.Find(Id);
+		if (!queue) {
+			queue = ClaimProducerQueue();
+			if (!queue) {
+				queue = new ProducerQueue();
+				queue->Owner = Id;
+				queue->References.store(2, std::memory_order_relaxed);
+				queue->Head = queue->Tail = new Chunk();
+
+				queue->NextQueue = Queues.load(std::memory_order_relaxed);
+				while (!Queues.compare_exchange_weak(queue->NextQueue, queue, std::memory_order_release,
+					std::memory_order_relaxed)) {
+				}
+			}
+
+			threadQueues.Add(queue);
+		}
+
+		owner = Id;
+		local = queue;
+		return *queue;
+	}
+
+	LineSubmitQueue::Chunk* LineSubmitQueue::AllocateChunk(ProducerQueue& queue)
+	{
+		if (queue.PendingChunks.load(std::memory_order_relaxed) >= MAX_PENDING_CHUNKS)
+			return nullptr;
+
+		Chunk* chunk = queue.FreeChunks.load(std::memory_order_acquire);
+		while (chunk && !queue.FreeChunks.compare_exchange_weak(chunk, chunk->NextFree, std::memory_order_acquire,
+							std::memory_order_acquire)) {
+		}
+
+		if (chunk) {
+			chunk->Count.store(0, std::memory_order_relaxed);
+			chunk->Next.store(nullptr, std::memory_order_relaxed);
+		} else {
+			chunk = new Chunk();
+		}
+
+		queue.PendingChunks.fetch_add(1, std::memory_order_relaxed);
+		return chunk;
+	}
+
+	void LineSubmitQueue::Push(std::span<const LineCommand> commands)
+	{
+		auto& queue = GetProducerQueue();
+
+		while (!commands.empty()) {
+			Chunk* tail = queue.Tail;
+			auto count = tail->Count.load(std::memory_order_relaxed);
+			if (count == Chunk::CAPACITY) {
+				Chunk* chunk = AllocateChunk(queue);
+				if (!chunk) {
+					Dropped.fetch_add(static_cast<std::uint32_t>(commands.size()), std::memory_order_relaxed);
+					return;
+				}
+
+				tail->Next.store(chunk, std::memory_order_release);
+				queue.Tail = tail = chunk;
+				count = 0;
+			}
+
+			const auto batch = std::min<std::size_t>(commands.size(), Chunk::CAPACITY - count);
+			std::copy_n(commands.begin(), batch, tail->Commands + count);
+			tail->Count.store(count + static_cast<std::uint32_t>(batch), std::memory_order_release);
+
+			commands = commands.subspan(batch);
+		}
+	}
+
+	void LineSubmitQueue::Push(const LineCommand& command)
+	{
+		auto& queue = GetProducerQueue();
+
+		Chunk* tail = queue.Tail;
+		auto count = tail->Count.load(std::memory_order_relaxed);
+		if (count == Chunk::CAPACITY) {
+			Chunk* chunk = AllocateChunk(queue);
+			if (!chunk) {
+				Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			tail->Next.store(chunk, std::memory_order_release);
+			queue.Tail = tail = chunk;
+			count = 0;
+		}
+
+		tail->Commands[count] = command;
+		tail->Count.store(count + 1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,219 @@
+#include "DebugAPI/NavmeshAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace DebugAPI_IMPL
+{
+	namespace NavmeshAnalyzer
+	{
+		static std::uint32_t FindRoot(std::vector<std::uint32_t>& parents, std::uint32_t node)
+		{
+			while (parents[node] != node) {
+				parents[node] = parents[parents[node]];
+				node = parents[node];
+			}
+			return node;
+		}
+	}
+
+	const char* NavmeshAnalyzer::GetIssueName(Issue issue)
+	{
+		switch (issue) {
+		case kBadIndex:
+			return "bad index";
+		case kDegenerate:
+			return "degenerate";
+		case kSliver:
+			return "sliver";
+		case kDuplicateVertex:
+			return "duplicate vertex";
+		case kNonManifoldEdge:
+			return "non-manifold edge";
+		case kIsland:
+			return "island";
+		default:
+			return "unknown";
+		}
+	}
+
+	NavmeshAnalyzer::MeshReport NavmeshAnalyzer::AnalyzeMesh(const MeshInput& mesh, const Thresholds& thresholds)
+	{
+		MeshReport report{ mesh.Key, {} };
+
+		const auto vertexCount = static_cast<std::uint32_t>(mesh.Vertices.size());
+		const auto triangleCount = static_cast<std::uint32_t>(mesh.Triangles.size());
+
+		// a vertex closer than DuplicateDistance to a lower index vertex is a duplicate. Vertices are bucketed on a grid of
+		// that size, so only the cells around a vertex can hold one that close
+		const float duplicateDistance = thresholds.DuplicateDistance;
+		auto getCell = [duplicateDistance](const glm::vec3& vertex) {
+			// clamped so the cast stays defined, 21 bits per axis is +-1M cells, well beyond a worldspace at the default
+			// distance
+			return glm::clamp(glm::floor(vertex / duplicateDistance), glm::vec3(-1048576.0f), glm::vec3(1048575.0f));
+		};
+		auto getCellKey = [](const glm::vec3& cell) {
+			auto quantize = [](float value) { return static_cast<std::uint64_t>(static_cast<std::int64_t>(value) & 0x1fffff); };
+			return quantize(cell.x) << 42 | quantize(cell.y) << 21 | quantize(cell.z);
+		};
+
+		// non-finite vertices are left out, they can't be on top of anything
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> vertexKeys;
+		vertexKeys.reserve(vertexCount);
+		for (std::uint32_t i = 0; i < vertexCount; i++) {
+			const auto& vertex = mesh.Vertices[i];
+			if (std::isfinite(vertex.x) && std::isfinite(vertex.y) && std::isfinite(vertex.z)) {
+				vertexKeys.emplace_back(getCellKey(getCell(vertex)), i);
+			}
+		}
+		std::sort(vertexKeys.begin(), vertexKeys.end());
+
+		std::vector<bool> duplicates(vertexCount);
+		for (const auto& [key, i] : vertexKeys) {
+			const auto& vertex = mesh.Vertices[i];
+			const auto cell = getCell(vertex);
+			for (int n = 0; n < 27 && !duplicates[i]; n++) {
+				const auto neighbour = getCellKey(cell + glm::vec3(n % 3 - 1, n / 3 % 3 - 1, n / 9 - 1));
+				auto it = std::lower_bound(vertexKeys.begin(), vertexKeys.end(), std::make_pair(neighbour, std::uint32_t(0)));
+				// sorted by index within a cell, only lower indices count
+				for (; it != vertexKeys.end() && it->first == neighbour && it->second < i; ++it) {
+					const auto offset = mesh.Vertices[it->second] - vertex;
+					if (glm::dot(offset, offset) < duplicateDistance * duplicateDistance) {
+						duplicates[i] = true;
+						break;
+					}
+				}
+			}
+		}
+
+		// edges of every triangle with valid, distinct indices, as (edge key, triangle)
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> edges;
+		edges.reserve(triangleCount * 3);
+		std::vector<float> areas(triangleCount);
+
+		for (std::uint32_t t = 0; t < triangleCount; t++) {
+			const auto& triangle = mesh.Triangles[t];
+			if (triangle[0] >= vertexCount || triangle[1] >= vertexCount || triangle[2] >= vertexCount) {
+				report.Findings.push_back({ t, kBadIndex });
+				continue;
+			}
+
+			if (duplicates[triangle[0]] || duplicates[triangle[1]] || duplicates[triangle[2]]) {
+				report.Findings.push_back({ t, kDuplicateVertex });
+			}
+
+			if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+				report.Findings.push_back({ t, kDegenerate });
+				continue;
+			}
+
+			for (int i = 0; i < 3; i++) {
+				const auto a = triangle[i];
+				const auto b = triangle[(i + 1) % 3];
+				edges.emplace_back(static_cast<std::uint64_t>(std::min(a, b)) << 32 | std::max(a, b), t);
+			}
+
+			const auto& p0 = mesh.Vertices[triangle[0]];
+			const auto& p1 = mesh.Vertices[triangle[1]];
+			const auto& p2 = mesh.Vertices[triangle[2]];
+			const float area = 0.5f * glm::length(glm::cross(p1 - p0, p2 - p0));
+			areas[t] = area;
+			if (area < thresholds.MinArea) {
+				report.Findings.push_back({ t, kDegenerate });
+				continue;
+			}
+
+			const auto lengthsSquared = glm::dot(p1 - p0, p1 - p0) + glm::dot(p2 - p1, p2 - p1) + glm::dot(p0 - p2, p0 - p2);
+			if (4.0f * std::sqrt(3.0f) * area / lengthsSquared < thresholds.MinQuality) {
+				report.Findings.push_back({ t, kSliver });
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+
+		// triangles sharing an edge are one group, so is a fan around a non-manifold edge
+		std::vector<std::uint32_t> parents(triangleCount);
+		std::iota(parents.begin(), parents.end(), 0);
+
+		std::vector<bool> connected(triangleCount);
+		for (std::size_t begin = 0; begin < edges.size();) {
+			auto end = begin + 1;
+			while (end < edges.size() && edges[end].first == edges[begin].first) {
+				end++;
+			}
+
+			for (auto i = begin; i < end; i++) {
+				connected[edges[i].second] = true;
+				if (end - begin > 2) {
+					report.Findings.push_back({ edges[i].second, kNonManifoldEdge });
+				}
+				if (i > begin) {
+					parents[FindRoot(parents, edges[i].second)] = FindRoot(parents, edges[begin].second);
+				}
+			}
+
+			begin = end;
+		}
+
+		// a triangle sharing no edge at all is its own group. Triangles with bad or repeated indices aren't part of any
+		std::vector<std::uint32_t> groupSizes(triangleCount);
+		std::vector<float> groupAreas(triangleCount);
+		for (std::uint32_t t = 0; t < triangleCount; t++) {
+			if (connected[t]) {
+				groupSizes[FindRoot(parents, t)]++;
+				groupAreas[FindRoot(parents, t)] += areas[t];
+			}
+		}
+
+		// groups of at least MaxIslandArea are parts of the navmesh in their own right, a rooftop or a room behind a door
+		const auto largest = std::max_element(groupSizes.begin(), groupSizes.end()) - groupSizes.begin();
+		for (std::uint32_t t = 0; t < triangleCount; t++) {
+			if (!connected[t])
+				continue;
+
+			const auto root = FindRoot(parents, t);
+			if (root != largest && groupAreas[root] < thresholds.MaxIslandArea) {
+				report.Findings.push_back({ t, kIsland });
+			}
+		}
+
+		// a triangle on several non-manifold edges is found once per edge
+		auto less = [](const Finding& a, const Finding& b) {
+			return a.Triangle != b.Triangle ? a.Triangle < b.Triangle : a.Kind < b.Kind;
+		};
+		auto equal = [](const Finding& a, const Finding& b) { return a.Triangle == b.Triangle && a.Kind == b.Kind; };
+		std::sort(report.Findings.begin(), report.Findings.end(), less);
+		report.Findings.erase(std::unique(report.Findings.begin(), report.Findings.end(), equal), report.Findings.end());
+
+		return report;
+	}
+
+	NavmeshAnalyzer::Report NavmeshAnalyzer::Analyze(std::span<const MeshInput> meshes, const Thresholds& thresholds)
+	{
+		std::vector<std::uint32_t> order(meshes.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(),
+			[&](std::uint32_t a, std::uint32_t b) { return meshes[a].Triangles.size() > meshes[b].Triangles.size(); });
+
+		std::vector<MeshReport> reports(meshes.size());
+		std::for_each(std::execution::par, order.begin(), order.end(),
+			[&](std::uint32_t mesh) { reports[mesh] = AnalyzeMesh(meshes[mesh], thresholds); });
+
+		Report report;
+		report.MeshCount = meshes.size();
+		for (std::size_t i = 0; i < meshes.size(); i++) {
+			report.TriangleCount += meshes[i].Triangles.size();
+			if (reports[i].Findings.empty())
+				continue;
+
+			for (const auto& finding : reports[i].Findings) {
+				report.Counts[finding.Kind]++;
+			}
+			report.Meshes.push_back(std::move(reports[i]));
+		}
+
+		return report;
+	}
+}
@@ -0,0 +1,221 @@
+#include "DebugAPI/NavmeshExport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace DebugAPI_IMPL
+{
+	namespace NavmeshExport
+	{
+		static std::uint64_t Align(std::uint64_t offset)
+		{
+			return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+		}
+	}
+
+	void NavmeshExport::Writer::AddMesh(std::uint32_t formID, std::uint32_t cellFormID, std::int32_t cellX,
+		std::int32_t cellY, std::span<const glm::vec3> vertices, std::span<const Triangle> triangles)
+	{
+		auto [slot, added] = Slots.try_emplace(formID, Meshes.size());
+		if (added) {
+			Meshes.emplace_back();
+		}
+
+		auto& mesh = Meshes[slot->second];
+		mesh.FormID = formID;
+		mesh.CellFormID = cellFormID;
+		mesh.CellX = cellX;
+		mesh.CellY = cellY;
+		mesh.Vertices.assign(vertices.begin(), vertices.end());
+		mesh.Triangles.assign(triangles.begin(), triangles.end());
+	}
+
+	bool NavmeshExport::Writer::Write(const std::filesystem::path& path, std::uint32_t worldFormID,
+		const std::string& worldName) const
+	{
+		std::vector<const PendingMesh*> sorted;
+		sorted.reserve(Meshes.size());
+		for (const auto& mesh : Meshes) {
+			sorted.push_back(&mesh);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](const PendingMesh* a, const PendingMesh* b) {
+			return a->CellFormID != b->CellFormID ? a->CellFormID < b->CellFormID : a->FormID < b->FormID;
+		});
+
+		std::vector<Cell> cells;
+		std::vector<Mesh> meshes;
+		meshes.reserve(sorted.size());
+
+		Header header{};
+		header.Magic = MAGIC;
+		header.Version = VERSION;
+		header.WorldFormID = worldFormID;
+		std::strncpy(header.WorldName, worldName.c_str(), sizeof(header.WorldName) - 1);
+
+		for (const auto* pending : sorted) {
+			if (cells.empty() || cells.back().FormID != pending->CellFormID) {
+				const auto firstMesh = static_cast<std::uint32_t>(meshes.size());
+				cells.push_back({ pending->CellFormID, pending->CellX, pending->CellY, firstMesh, 0 });
+			}
+			cells.back().MeshCount++;
+
+			meshes.push_back({ pending->FormID, static_cast<std::uint32_t>(cells.size() - 1),
+				static_cast<std::uint32_t>(pending->Vertices.size()), static_cast<std::uint32_t>(pending->Triangles.size()),
+				header.VertexCount, header.TriangleCount });
+			header.VertexCount += pending->Vertices.size();
+			header.TriangleCount += pending->Triangles.size();
+		}
+
+		header.CellCount = static_cast<std::uint32_t>(cells.size());
+		header.MeshCount = static_cast<std::uint32_t>(meshes.size());
+		header.CellOffset = Align(sizeof(Header));
+		header.MeshOffset = Align(header.CellOffset + cells.size() * sizeof(Cell));
+		header.VertexOffset = Align(header.MeshOffset + meshes.size() * sizeof(Mesh));
+		header.TriangleOffset = Align(header.VertexOffset + header.VertexCount * sizeof(glm::vec3));
+		header.FileSize = header.TriangleOffset + header.TriangleCount * sizeof(Triangle);
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+			return false;
+
+		auto pad = [&](std::uint64_t offset) {
+			static constexpr char zeros[SECTION_ALIGNMENT]{};
+			stream.write(zeros, offset - static_cast<std::uint64_t>(stream.tellp()));
+		};
+
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		pad(header.CellOffset);
+		stream.write(reinterpret_cast<const char*>(cells.data()), cells.size() * sizeof(Cell));
+		pad(header.MeshOffset);
+		stream.write(reinterpret_cast<const char*>(meshes.data()), meshes.size() * sizeof(Mesh));
+		pad(header.VertexOffset);
+		for (const auto* pending : sorted) {
+			stream.write(reinterpret_cast<const char*>(pending->Vertices.data()), pending->Vertices.size() * sizeof(glm::vec3));
+		}
+		pad(header.TriangleOffset);
+		for (const auto* pending : sorted) {
+			stream.write(reinterpret_cast<const char*>(pending->Triangles.data()), pending->Triangles.size() * sizeof(Triangle));
+		}
+
+		return static_cast<bool>(stream.flush());
+	}
+
+	bool NavmeshExport::View::Open(const std::filesystem::path& path)
+	{
+		Close();
+
+#ifdef _WIN32
+		File = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (File == INVALID_HANDLE_VALUE) {
+			File = nullptr;
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(File, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+			Close();
+			return false;
+		}
+
+		Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!Mapping) {
+			Close();
+			return false;
+		}
+
+		Data = static_cast<const std::uint8_t*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+		Size = static_cast<std::uint64_t>(size.QuadPart);
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(file, &status) || status.st_size < static_cast<off_t>(sizeof(Header))) {
+			close(file);
+			return false;
+		}
+
+		// the mapping stays valid after the descriptor is closed
+		void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		Data = static_cast<const std::uint8_t*>(data);
+		Size = static_cast<std::uint64_t>(status.st_size);
+#endif
+
+		if (!Data || !Validate()) {
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void NavmeshExport::View::Close()
+	{
+#ifdef _WIN32
+		if (Data) {
+			UnmapViewOfFile(Data);
+		}
+		if (Mapping) {
+			CloseHandle(Mapping);
+		}
+		if (File) {
+			CloseHandle(File);
+		}
+		Mapping = nullptr;
+		File = nullptr;
+#else
+		if (Data) {
+			munmap(const_cast<std::uint8_t*>(Data), Size);
+		}
+#endif
+		Data = nullptr;
+		Size = 0;
+	}
+
+	bool NavmeshExport::View::Validate() const
+	{
+		const auto& header = GetHeader();
+		if (header.Magic != MAGIC || header.Version != VERSION || header.FileSize != Size)
+			return false;
+
+		// divides instead of multiplying, so bogus counts can't overflow
+		auto fits = [this](std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize) {
+			return offset % SECTION_ALIGNMENT == 0 && offset <= Size && count <= (Size - offset) / elementSize;
+		};
+		if (!fits(header.CellOffset, header.CellCount, sizeof(Cell)) ||
+			!fits(header.MeshOffset, header.MeshCount, sizeof(Mesh)) ||
+			!fits(header.VertexOffset, header.VertexCount, sizeof(glm::vec3)) ||
+			!fits(header.TriangleOffset, header.TriangleCount, sizeof(Triangle)))
+			return false;
+
+		for (const auto& cell : GetCells()) {
+			if (cell.FirstMesh > header.MeshCount || cell.MeshCount > header.MeshCount - cell.FirstMesh)
+				return false;
+		}
+
+		for (const auto& mesh : GetMeshes()) {
+			if (mesh.Cell >= header.CellCount || mesh.FirstVertex > header.VertexCount ||
+				mesh.VertexCount > header.VertexCount - mesh.FirstVertex || mesh.FirstTriangle > header.TriangleCount ||
+				mesh.TriangleCount > header.TriangleCount - mesh.FirstTriangle)
+				return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,294 @@
+#include "DebugAPI/NavmeshGraph.h"
+
+#include <algorithm>
+#include <execution>
+#include <limits>
+
+namespace DebugAPI_IMPL
+{
+	void NavmeshGraph::Build(std::span<const NavmeshGeometry* const> meshes)
+	{
+		Centroids.clear();
+		Corners.clear();
+
+		struct Adjacency
+		{
+			std::uint32_t A;
+			std::uint32_t B;
+			glm::vec3 Portal;
+		};
+		std::vector<Adjacency> adjacencies;
+
+		// an edge only one triangle of its navmesh uses, keyed by its quantized endpoints in a fixed order
+		struct BoundaryEdge
+		{
+			std::pair<std::uint64_t, std::uint64_t> Key;
+			std::uint32_t Node;
+			glm::vec3 Portal;
+		};
+		std::vector<BoundaryEdge> boundary;
+
+		auto quantize = [](const glm::vec3& point) {
+			// 21 bits per axis covers +-4M units at the default grid
+			auto axis = [](float value) {
+				return static_cast<std::uint64_t>(static_cast<std::int64_t>(std::round(value / PORTAL_GRID)) & 0x1fffff);
+			};
+			return axis(point.x) << 42 | axis(point.y) << 21 | axis(point.z);
+		};
+
+		std::vector<std::uint32_t> edgeOwners;
+		std::vector<std::uint8_t> edgeUses;
+		for (const auto* mesh : meshes) {
+			const auto base = static_cast<std::uint32_t>(Centroids.size());
+			const auto& points = mesh->Points;
+
+			edgeOwners.assign(mesh->Edges.size(), INVALID_NODE);
+			edgeUses.assign(mesh->Edges.size(), 0);
+
+			for (std::uint32_t t = 0; t < mesh->Triangles.size(); t++) {
+				const auto& triangle = mesh->Triangles[t];
+				Centroids.push_back(mesh->Centroids[t]);
+				Corners.push_back({ points[triangle[0]], points[triangle[1]], points[triangle[2]] });
+
+				for (auto edge : mesh->TriangleEdges[t]) {
+					const auto [from, to] = mesh->Edges[edge];
+					if (edgeOwners[edge] == INVALID_NODE) {
+						edgeOwners[edge] = base + t;
+					} else {
+						adjacencies.push_back({ edgeOwners[edge], base + t, (points[from] + points[to]) * 0.5f });
+					}
+					edgeUses[edge] = static_cast<std::uint8_t>(std::min(edgeUses[edge] + 1, 2));
+				}
+			}
+
+			for (std::uint32_t edge = 0; edge < mesh->Edges.size(); edge++) {
+				if (edgeUses[edge] != 1)
+					continue;
+
+				const auto [from, to] = mesh->Edges[edge];
+				const auto a = quantize(points[from]);
+				const auto b = quantize(points[to]);
+				boundary.push_back({ { std::min(a, b), std::max(a, b) }, edgeOwners[edge], (points[from] + points[to]) * 0.5f });
+			}
+		}
+
+		std::sort(boundary.begin(), boundary.end(), [](const BoundaryEdge& a, const BoundaryEdge& b) { return a.Key < b.Key; });
+		for (std::size_t begin = 0; begin < boundary.size();) {
+			auto end = begin + 1;
+			for (; end < boundary.size() && boundary[end].Key == boundary[begin].Key; end++) {
+				adjacencies.push_back({ boundary[begin].Node, boundary[end].Node, boundary[begin].Portal });
+			}
+			begin = end;
+		}
+
+		// counting sort of both directions of every adjacency into the CSR arrays
+		const auto nodeCount = GetNodeCount();
+		Offsets.assign(nodeCount + 1, 0);
+		for (const auto& adjacency : adjacencies) {
+			Offsets[adjacency.A + 1]++;
+			Offsets[adjacency.B + 1]++;
+		}
+		for (std::uint32_t i = 0; i < nodeCount; i++) {
+			Offsets[i + 1] += Offsets[i];
+		}
+
+		Links.resize(adjacencies.size() * 2);
+		std::vector<std::uint32_t> cursors(Offsets.begin(), Offsets.end() - 1);
+		for (const auto& adjacency : adjacencies) {
+			const float cost = glm::distance(Centroids[adjacency.A], Centroids[adjacency.B]);
+			Links[cursors[adjacency.A]++] = { adjacency.B, cost, adjacency.Portal };
+			Links[cursors[adjacency.B]++] = { adjacency.A, cost, adjacency.Portal };
+		}
+
+		// FindNode grid, a node is in every cell its XY bounds touch
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> cellRefs;
+		for (std::uint32_t node = 0; node < nodeCount; node++) {
+			const auto& corners = Corners[node];
+			const auto min = glm::min(corners[0], glm::min(corners[1], corners[2]));
+			const auto max = glm::max(corners[0], glm::max(corners[1], corners[2]));
+			for (auto x = Quantize(min.x); x <= Quantize(max.x); x++) {
+				for (auto y = Quantize(min.y); y <= Quantize(max.y); y++) {
+					cellRefs.emplace_back(MakeKey(x, y), node);
+				}
+			}
+		}
+		std::sort(cellRefs.begin(), cellRefs.end());
+
+		Cells.clear();
+		CellNodes.resize(cellRefs.size());
+		for (std::uint32_t i = 0; i < cellRefs.size(); i++) {
+			CellNodes[i] = cellRefs[i].second;
+			auto [cell, added] = Cells.try_emplace(cellRefs[i].first, i, i + 1);
+			if (!added) {
+				cell->second.second = i + 1;
+			}
+		}
+	}
+
+	std::uint32_t NavmeshGraph::FindNode(const glm::vec3& position) const
+	{
+		if (!NavmeshGeometry::IsInBounds(position))
+			return INVALID_NODE;
+
+		auto cell = Cells.find(MakeKey(Quantize(position.x), Quantize(position.y)));
+		if (cell == Cells.end())
+			return INVALID_NODE;
+
+		auto side = [](const glm::vec3& a, const glm::vec3& b, const glm::vec3& p) {
+			return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+		};
+
+		std::uint32_t best = INVALID_NODE;
+		float bestDistance = std::numeric_limits<float>::max();
+		std::uint32_t closest = INVALID_NODE;
+		float closestDistance = std::numeric_limits<float>::max();
+
+		for (auto i = cell->second.first; i < cell->second.second; i++) {
+			const auto node = CellNodes[i];
+			const auto& corners = Corners[node];
+
+			const float centroidDistance = glm::distance(Centroids[node], position);
+			if (centroidDistance < closestDistance) {
+				closestDistance = centroidDistance;
+				closest = node;
+			}
+
+			const float area = side(corners[0], corners[1], corners[2]);
+			const float d0 = side(corners[1], corners[2], position);
+			const float d1 = side(corners[2], corners[0], position);
+			const float d2 = side(corners[0], corners[1], position);
+			const bool inside = area > 0.0f ? d0 >= 0.0f && d1 >= 0.0f && d2 >= 0.0f : d0 <= 0.0f && d1 <= 0.0f && d2 <= 0.0f;
+			if (area == 0.0f || !inside)
+				continue;
+
+			// height of the triangle under position
+			const float z = (d0 * corners[0].z + d1 * corners[1].z + d2 * corners[2].z) / area;
+			if (std::abs(z - position.z) < bestDistance) {
+				bestDistance = std::abs(z - position.z);
+				best = node;
+			}
+		}
+
+		return best != INVALID_NODE ? best : closest;
+	}
+
+	bool NavmeshPathfinder::FindPath(const NavmeshGraph& graph, const glm::vec3& from, const glm::vec3& to,
+		std::vector<glm::vec3>& path, std::uint32_t maxExpansions)
+	{
+		path.clear();
+
+		const auto start = graph.FindNode(from);
+		const auto goal = graph.FindNode(to);
+		if (start == NavmeshGraph::INVALID_NODE || goal == NavmeshGraph::INVALID_NODE)
+			return false;
+
+		if (Nodes.size() < graph.GetNodeCount()) {
+			Nodes.resize(graph.GetNodeCount(), NodeState{});
+		}
+
+		if (++Stamp == 0) {
+			// wrapped around, old stamps could collide with the new ones
+			for (auto& node : Nodes) {
+				node.Stamp = 0;
+				node.ClosedStamp = 0;
+			}
+			Stamp = 1;
+		}
+
+		// straight line distance never overestimates the centroid to centroid costs, so closed nodes stay closed
+		const auto& goalPosition = graph.GetCentroid(goal);
+		auto estimate = [&](std::uint32_t node) { return glm::distance(graph.GetCentroid(node), goalPosition); };
+
+		Open.clear();
+		Nodes[start] = { 0.0f, NavmeshGraph::INVALID_NODE, Stamp, 0 };
+		Open.push_back({ estimate(start), start });
+
+		// nodes are pushed again instead of decreasing their key, stale entries are skipped when popped
+		bool found = false;
+		std::uint32_t expansions = 0;
+		while (!Open.empty() && expansions < maxExpansions) {
+			std::pop_heap(Open.begin(), Open.end());
+			const auto node = Open.back().Node;
+			Open.pop_back();
+
+			auto& state = Nodes[node];
+			if (state.ClosedStamp == Stamp)
+				continue;
+			state.ClosedStamp = Stamp;
+
+			if (node == goal) {
+				found = true;
+				break;
+			}
+			expansions++;
+
+			for (const auto& link : graph.GetLinks(node)) {
+				auto& next = Nodes[link.Node];
+				const float cost = state.Cost + link.Cost;
+				if (next.Stamp == Stamp && (next.ClosedStamp == Stamp || next.Cost <= cost))
+					continue;
+
+				if (next.Stamp != Stamp) {
+					next.ClosedStamp = 0;
+				}
+				next.Cost = cost;
+				next.Parent = node;
+				next.Stamp = Stamp;
+
+				Open.push_back({ cost + estimate(link.Node), link.Node });
+				std::push_heap(Open.begin(), Open.end());
+			}
+		}
+
+		if (!found)
+			return false;
+
+		// walked back from the goal, the portal into each node is looked up again in its parent's links
+		path.push_back(to);
+		for (auto node = goal; Nodes[node].Parent != NavmeshGraph::INVALID_NODE; node = Nodes[node].Parent) {
+			for (const auto& link : graph.GetLinks(Nodes[node].Parent)) {
+				if (link.Node == node) {
+					path.push_back(link.Portal);
+					break;
+				}
+			}
+		}
+		path.push_back(from);
+
+		std::reverse(path.begin(), path.end());
+		return true;
+	}
+
+	void NavmeshPathfinderPool::Run(const NavmeshGraph& graph, std::span<const Query> queries,
+		std::vector<std::vector<glm::vec3>>& paths)
+	{
+		paths.resize(queries.size());
+
+		std::for_each(std::execution::par, paths.begin(), paths.end(), [&](std::vector<glm::vec3>& path) {
+			const auto& query = queries[&path - paths.data()];
+
+			auto pathfinder = Acquire();
+			pathfinder->FindPath(graph, query.From, query.To, path);
+			Release(pathfinder);
+		});
+	}
+
+	NavmeshPathfinder* NavmeshPathfinderPool::Acquire()
+	{
+		std::lock_guard<std::mutex> lg(Mutex);
+		if (Free.empty()) {
+			Pathfinders.push_back(std::make_unique<NavmeshPathfinder>());
+			return Pathfinders.back().get();
+		}
+
+		auto pathfinder = Free.back();
+		Free.pop_back();
+		return pathfinder;
+	}
+
+	void NavmeshPathfinderPool::Release(NavmeshPathfinder* pathfinder)
+	{
+		std::lock_guard<std::mutex> lg(Mutex);
+		Free.push_back(pathfinder);
+	}
+}
@@ -0,0 +1,131 @@
+#include "DebugAPI/NavmeshGrid.h"
+
+#include <algorithm>
+
+namespace DebugAPI_IMPL
+{
+	void NavmeshGeometry::Build(std::vector<glm::vec3> points, const std::vector<std::array<std::uint32_t, 3>>& triangles)
+	{
+		Points = std::move(points);
+		Triangles.clear();
+		Centroids.clear();
+
+		auto edgeKey = [](std::uint32_t a, std::uint32_t b) {
+			return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+		};
+
+		std::vector<std::uint64_t> edgeKeys;
+		edgeKeys.reserve(triangles.size() * 3);
+
+		const auto pointCount = static_cast<std::uint32_t>(Points.size());
+		for (const auto& triangle : triangles) {
+			if (triangle[0] >= pointCount || triangle[1] >= pointCount || triangle[2] >= pointCount)
+				continue;
+
+			const auto& p0 = Points[triangle[0]];
+			const auto& p1 = Points[triangle[1]];
+			const auto& p2 = Points[triangle[2]];
+			if (!IsInBounds(p0) || !IsInBounds(p1) || !IsInBounds(p2))
+				continue;
+
+			const auto size = glm::max(p0, glm::max(p1, p2)) - glm::min(p0, glm::min(p1, p2));
+			if (size.x > MAX_TRIANGLE_SIZE || size.y > MAX_TRIANGLE_SIZE)
+				continue;
+
+			Triangles.push_back(triangle);
+			Centroids.push_back((p0 + p1 + p2) * (1.0f / 3.0f));
+
+			for (int i = 0; i < 3; i++) {
+				edgeKeys.push_back(edgeKey(triangle[i], triangle[(i + 1) % 3]));
+			}
+		}
+
+		std::sort(edgeKeys.begin(), edgeKeys.end());
+		edgeKeys.erase(std::unique(edgeKeys.begin(), edgeKeys.end()), edgeKeys.end());
+
+		Edges.clear();
+		Edges.reserve(edgeKeys.size());
+		for (auto key : edgeKeys) {
+			Edges.emplace_back(static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key));
+		}
+
+		TriangleEdges.resize(Triangles.size());
+		for (std::size_t i = 0; i < Triangles.size(); i++) {
+			for (int j = 0; j < 3; j++) {
+				auto key = edgeKey(Triangles[i][j], Triangles[i][(j + 1) % 3]);
+				TriangleEdges[i][j] =
+					static_cast<std::uint32_t>(std::lower_bound(edgeKeys.begin(), edgeKeys.end(), key) - edgeKeys.begin());
+			}
+		}
+	}
+
+	void NavmeshGrid::AddMesh(std::uint32_t key, NavmeshGeometry geometry)
+	{
+		RemoveMesh(key);
+
+		std::uint32_t slot;
+		if (!FreeMeshes.empty()) {
+			slot = FreeMeshes.back();
+			FreeMeshes.pop_back();
+		} else {
+			slot = static_cast<std::uint32_t>(Meshes.size());
+			Meshes.emplace_back();
+		}
+
+		auto& mesh = Meshes[slot];
+		mesh.Key = key;
+		mesh.Geometry = std::move(geometry);
+		mesh.GridCells.clear();
+		mesh.TriangleStamps.assign(mesh.Geometry.Triangles.size(), 0);
+		mesh.EdgeStamps.assign(mesh.Geometry.Edges.size(), 0);
+		mesh.PointStamps.assign(mesh.Geometry.Points.size(), 0);
+
+		const auto& points = mesh.Geometry.Points;
+		for (std::uint32_t i = 0; i < mesh.Geometry.Triangles.size(); i++) {
+			const auto& triangle = mesh.Geometry.Triangles[i];
+			const auto min = glm::min(points[triangle[0]], glm::min(points[triangle[1]], points[triangle[2]]));
+			const auto max = glm::max(points[triangle[0]], glm::max(points[triangle[1]], points[triangle[2]]));
+
+			for (auto x = Quantize(min.x); x <= Quantize(max.x); x++) {
+				for (auto y = Quantize(min.y); y <= Quantize(max.y); y++) {
+					const auto cellKey = MakeKey(x, y);
+					auto& refs = Grid[cellKey];
+					if (refs.empty() || refs.back().Mesh != slot) {
+						mesh.GridCells.push_back(cellKey);
+					}
+					refs.push_back({ slot, i });
+				}
+			}
+		}
+
+		std::sort(mesh.GridCells.begin(), mesh.GridCells.end());
+		mesh.GridCells.erase(std::unique(mesh.GridCells.begin(), mesh.GridCells.end()), mesh.GridCells.end());
+
+		Slots[key] = slot;
+	}
+
+	void NavmeshGrid::RemoveMesh(std::uint32_t key)
+	{
+		auto it = Slots.find(key);
+		if (it == Slots.end())
+			return;
+
+		const auto slot = it->second;
+		auto& mesh = Meshes[slot];
+		for (auto cellKey : mesh.GridCells) {
+			auto cell = Grid.find(cellKey);
+			if (cell == Grid.end())
+				continue;
+
+			std::erase_if(cell->second, [slot](const TriangleRef& ref) { return ref.Mesh == slot; });
+			if (cell->second.empty()) {
+				Grid.erase(cell);
+			}
+		}
+
+		mesh.Geometry = {};
+		mesh.GridCells.clear();
+		FreeMeshes.push_back(slot);
+		Slots.erase(it);
+	}
+}
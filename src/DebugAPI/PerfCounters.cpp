@@ -0,0 +1,75 @@
+#include "DebugAPI/PerfCounters.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace DebugAPI_IMPL
+{
+	void PerfCounters::Record(Timer timer, float microseconds)
+	{
+		auto& histogram = Histograms[timer];
+		const auto index = histogram.Count.fetch_add(1, std::memory_order_relaxed) % HISTOGRAM_SAMPLES;
+		histogram.Samples[index].store(microseconds, std::memory_order_relaxed);
+	}
+
+	void PerfCounters::EndFrame()
+	{
+		auto& slot = History[HistoryPos];
+		for (std::uint32_t i = 0; i < kCounterCount; i++) {
+			const auto count = Frame[i].exchange(0, std::memory_order_relaxed);
+			Sums[i].fetch_add(count - static_cast<std::uint64_t>(slot[i]), std::memory_order_relaxed);
+			slot[i] = count;
+		}
+
+		HistoryPos = (HistoryPos + 1) % WINDOW_FRAMES;
+		if (HistoryCount.load(std::memory_order_relaxed) < WINDOW_FRAMES) {
+			HistoryCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	float PerfCounters::GetAverage(Counter counter) const
+	{
+		const auto frames = HistoryCount.load(std::memory_order_relaxed);
+		if (!frames)
+			return 0.0f;
+
+		return static_cast<float>(Sums[counter].load(std::memory_order_relaxed)) / frames;
+	}
+
+	float PerfCounters::GetPercentile(Timer timer, float percentile) const
+	{
+		const auto& histogram = Histograms[timer];
+		const auto count = std::min(histogram.Count.load(std::memory_order_relaxed), HISTOGRAM_SAMPLES);
+		if (!count)
+			return 0.0f;
+
+		std::array<float, HISTOGRAM_SAMPLES> samples;
+		for (std::uint32_t i = 0; i < count; i++) {
+			samples[i] = histogram.Samples[i].load(std::memory_order_relaxed);
+		}
+
+		const auto nth = samples.begin() + std::min(static_cast<std::uint32_t>(percentile * (count - 1) + 0.5f), count - 1);
+		std::nth_element(samples.begin(), nth, samples.begin() + count);
+		return *nth;
+	}
+
+	std::string PerfCounters::Format() const
+	{
+		char buffer[512];
+		std::snprintf(buffer, sizeof(buffer),
+			"lines: %.0f live, %.0f drawn (%.0f polylines), %.0f culled, %.0f too short, %.0f over budget, %.0f expired\n"
+			"submitted: %.0f, %.0f dropped, %.0f merged, %.0f transient, %.1f invokes | "
+			"batches: %.0f lines, %.0f reprojected\n"
+			"render: p50 %.0fus p99 %.0fus | navmesh sync: p50 %.0fus p99 %.0fus | build: p50 %.0fus p99 %.0fus\n"
+			"paths: p50 %.0fus p99 %.0fus | skeletons: p50 %.0fus p99 %.0fus",
+			GetAverage(kLive), GetAverage(kDrawn), GetAverage(kPolylines), GetAverage(kCulled), GetAverage(kTooShort),
+			GetAverage(kOverBudget), GetAverage(kExpired), GetAverage(kSubmitted), GetAverage(kDropped),
+			GetAverage(kMerged), GetAverage(kTransient), GetAverage(kInvokes), GetAverage(kBatchLines),
+			GetAverage(kReprojected),
+			GetPercentile(kRenderFrame, 0.5f), GetPercentile(kRenderFrame, 0.99f), GetPercentile(kNavmeshSync, 0.5f),
+			GetPercentile(kNavmeshSync, 0.99f), GetPercentile(kNavmeshBuild, 0.5f), GetPercentile(kNavmeshBuild, 0.99f),
+			GetPercentile(kNavmeshPaths, 0.5f), GetPercentile(kNavmeshPaths, 0.99f), GetPercentile(kSkeletons, 0.5f),
+			GetPercentile(kSkeletons, 0.99f));
+		return buffer;
+	}
+}
@@ -0,0 +1,200 @@
+#include "DebugAPI/Projection.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <vector>
+
+#include <immintrin.h>
+
+namespace DebugAPI_IMPL
+{
+	glm::vec2 Projection::ProjectPoint(const CameraSnapshot& snapshot, const glm::vec3& point)
+	{
+		glm::vec4 clip = TransformToClip(snapshot, point);
+		clip.w = std::max(clip.w, ZERO_TOLERANCE);
+		return ClipToScreen(snapshot, clip);
+	}
+
+	glm::vec4 Projection::TransformToClip(const CameraSnapshot& snapshot, const glm::vec3& point)
+	{
+		const auto& m = snapshot.WorldToCam;
+		return glm::vec4(m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3],
+			m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3],
+			m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3],
+			m[3][0] * point.x + m[3][1] * point.y + m[3][2] * point.z + m[3][3]);
+	}
+
+	glm::vec2 Projection::ClipToScreen(const CameraSnapshot& snapshot, const glm::vec4& clip)
+	{
+		const float invW = 1.0f / clip.w;
+		float x = clip.x * invW;
+		float y = clip.y * invW;
+
+		// NiCamera::WorldPtToScreenPt3, normalized device coordinates to the camera's port
+		x = x * (snapshot.PortRight - snapshot.PortLeft) * 0.5f + (snapshot.PortLeft + snapshot.PortRight) * 0.5f;
+		y = y * (snapshot.PortTop - snapshot.PortBottom) * 0.5f + (snapshot.PortTop + snapshot.PortBottom) * 0.5f;
+
+		glm::vec2 screenLocOut;
+		screenLocOut.x = snapshot.RectLeft + (snapshot.RectRight - snapshot.RectLeft) * x;
+		screenLocOut.y = 1.0f - y;  // Flip y for Flash coordinate system
+		screenLocOut.y = snapshot.RectTop + (snapshot.RectBottom - snapshot.RectTop) * screenLocOut.y;
+
+		return screenLocOut;
+	}
+
+	namespace Projection
+	{
+		enum ClipPlane : std::uint32_t
+		{
+			kLeft = 1 << 0,
+			kRight = 1 << 1,
+			kBottom = 1 << 2,
+			kTop = 1 << 3,
+			kNear = 1 << 4
+		};
+
+		// signed distance to the plane, inside is >= 0
+		static inline float PlaneDistance(const glm::vec4& p, std::uint32_t plane)
+		{
+			switch (plane) {
+			case kLeft:
+				return p.w + p.x;
+			case kRight:
+				return p.w - p.x;
+			case kBottom:
+				return p.w + p.y;
+			case kTop:
+				return p.w - p.y;
+			default:
+				return p.w - NEAR_PLANE_W;
+			}
+		}
+
+		static inline std::uint32_t OutCode(const glm::vec4& p)
+		{
+			std::uint32_t code = 0;
+			for (std::uint32_t plane = kLeft; plane <= kNear; plane <<= 1) {
+				if (PlaneDistance(p, plane) < 0.0f)
+					code |= plane;
+			}
+			return code;
+		}
+	}
+
+	bool Projection::ClipSegment(glm::vec4& from, glm::vec4& to)
+	{
+		std::uint32_t codeFrom = OutCode(from);
+		std::uint32_t codeTo = OutCode(to);
+
+		// a plane an endpoint was already moved onto is never tested again for that endpoint, otherwise rounding could
+		// keep reporting it as outside forever
+		std::uint32_t clippedFrom = 0;
+		std::uint32_t clippedTo = 0;
+
+		while (true) {
+			if (!(codeFrom | codeTo))
+				return true;
+
+			// both endpoints are outside the same plane, so is everything in between
+			if (codeFrom & codeTo)
+				return false;
+
+			const bool clipFrom = codeFrom != 0;
+			const std::uint32_t plane = std::uint32_t(1) << std::countr_zero(clipFrom ? codeFrom : codeTo);
+
+			const float distFrom = PlaneDistance(from, plane);
+			const float distTo = PlaneDistance(to, plane);
+
+			// only left over from rounding, the segment lies (almost) on the plane
+			if (clipFrom ? distTo <= distFrom : distFrom <= distTo)
+				return false;
+
+			const glm::vec4 intersection = from + (to - from) * (distFrom / (distFrom - distTo));
+
+			if (clipFrom) {
+				from = intersection;
+				clippedFrom |= plane;
+				codeFrom = OutCode(from) & ~clippedFrom;
+			} else {
+				to = intersection;
+				clippedTo |= plane;
+				codeTo = OutCode(to) & ~clippedTo;
+			}
+		}
+	}
+
+	namespace Projection
+	{
+		// transforms 4 points starting at points[0], evaluating exactly the same operations as TransformToClip
+		static inline void TransformToClip4(const CameraSnapshot& snapshot, const glm::vec3* points, glm::vec4* out)
+		{
+			const auto& m = snapshot.WorldToCam;
+
+			const __m128 px = _mm_setr_ps(points[0].x, points[1].x, points[2].x, points[3].x);
+			const __m128 py = _mm_setr_ps(points[0].y, points[1].y, points[2].y, points[3].y);
+			const __m128 pz = _mm_setr_ps(points[0].z, points[1].z, points[2].z, points[3].z);
+
+			auto row = [&](int r) {
+				__m128 v = _mm_mul_ps(_mm_set1_ps(m[r][0]), px);
+				v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(m[r][1]), py));
+				v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(m[r][2]), pz));
+				return _mm_add_ps(v, _mm_set1_ps(m[r][3]));
+			};
+
+			__m128 x = row(0);
+			__m128 y = row(1);
+			__m128 z = row(2);
+			__m128 w = row(3);
+
+			// structure of arrays back to one x, y, z, w per point
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(&out[0].x, x);
+			_mm_storeu_ps(&out[1].x, y);
+			_mm_storeu_ps(&out[2].x, z);
+			_mm_storeu_ps(&out[3].x, w);
+		}
+
+		static void TransformToClipSerial(const CameraSnapshot& snapshot, const glm::vec3* points, glm::vec4* out,
+			std::size_t count)
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				TransformToClip4(snapshot, points + i, out + i);
+			}
+
+			for (; i < count; i++) {
+				out[i] = TransformToClip(snapshot, points[i]);
+			}
+		}
+	}
+
+	void Projection::TransformToClip(const CameraSnapshot& snapshot, const glm::vec3* points, glm::vec4* out,
+		std::size_t count)
+	{
+		if (count < PARALLEL_MIN_POINTS) {
+			TransformToClipSerial(snapshot, points, out, count);
+			return;
+		}
+
+		const std::size_t chunkCount = (count + PARALLEL_CHUNK_POINTS - 1) / PARALLEL_CHUNK_POINTS;
+		std::vector<std::size_t> chunks(chunkCount);
+		std::iota(chunks.begin(), chunks.end(), std::size_t(0));
+
+		std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](std::size_t chunk) {
+			const std::size_t first = chunk * PARALLEL_CHUNK_POINTS;
+			const std::size_t chunkSize = std::min(PARALLEL_CHUNK_POINTS, count - first);
+			TransformToClipSerial(snapshot, points + first, out + first, chunkSize);
+		});
+	}
+
+	void Projection::TransformToClipScalar(const CameraSnapshot& snapshot, const glm::vec3* points, glm::vec4* out,
+		std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; i++) {
+			out[i] = TransformToClip(snapshot, points[i]);
+		}
+	}
+}
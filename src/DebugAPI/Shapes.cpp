@@ -0,0 +1,39 @@
+#include "DebugAPI/Shapes.h"
+
+#include <cmath>
+
+namespace DebugAPI_IMPL
+{
+	std::span<const Shapes::UnitCirclePoint> Shapes::GetUnitCircle(std::uint32_t segments)
+	{
+		if (segments <= 8)
+			return UNIT_CIRCLE_8;
+		if (segments <= 16)
+			return UNIT_CIRCLE_16;
+		if (segments <= 32)
+			return UNIT_CIRCLE_32;
+		return UNIT_CIRCLE_64;
+	}
+
+	void Shapes::AppendCircle(std::vector<glm::vec3>& out, const glm::vec3& origin, const glm::vec3& u, const glm::vec3& v,
+		float radius, std::uint32_t segments, std::uint32_t count)
+	{
+		const auto table = GetUnitCircle(segments);
+		const glm::vec3 ru = u * radius;
+		const glm::vec3 rv = v * radius;
+
+		for (std::uint32_t i = 0; i < count; i++) {
+			// count may be one past a half circle, wrap around for the closing point of a full one
+			const auto& point = table[i % table.size()];
+			out.push_back(origin + ru * point.Cos + rv * point.Sin);
+		}
+	}
+
+	void Shapes::GetBasis(const glm::vec3& axis, glm::vec3& u, glm::vec3& v)
+	{
+		// any vector not parallel to the axis works as a seed
+		const glm::vec3 seed = std::abs(axis.z) < 0.9f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		u = glm::normalize(glm::cross(axis, seed));
+		v = glm::cross(axis, u);
+	}
+}
@@ -47,6 +47,7 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Query(const SKSE::QueryInterface* a
 
 #define NOGDI
 #include <xbyak\xbyak.h>
+#include <SimpleIni.h>
 #include <glm/glm.hpp>
 #include <glm/ext.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -54,21 +55,56 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Query(const SKSE::QueryInterface* a
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <cassert>
+#include <condition_variable>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <thread>
+
+#include "DebugAPI/LineRenderer.h"
+#include "DebugAPI/Math.h"
+#include "DebugAPI/NavmeshAnalyzer.h"
+#include "DebugAPI/NavmeshExport.h"
+#include "DebugAPI/NavmeshGraph.h"
+#include "DebugAPI/NavmeshGrid.h"
+#include "DebugAPI/Shapes.h"
+
 namespace DebugAPI_IMPL
 {
-	class DebugAPILine
+	// Data/SKSE/Plugins/CreationKitInSkyrim.ini, read once on kDataLoaded. Missing keys keep their defaults
+	class Settings
 	{
 	public:
-		DebugAPILine(glm::vec3 from, glm::vec3 to, glm::vec4 color, float lineThickness, unsigned __int64 destroyTickCount);
-
-		glm::vec3 From;
-		glm::vec3 To;
-		glm::vec4 Color;
-		float fColor;
-		float Alpha;
-		float LineThickness;
-
-		unsigned __int64 DestroyTickCount;
+		static void Load();
+
+		static std::string GetPath() { return "Data/SKSE/Plugins/"s + std::string(Version::PROJECT) + ".ini"s; }
+
+		// [Capture] bEnabled: records the overlay's line stream and camera to CreationKitInSkyrim.capture next to the
+		// log, for replaying it with CreationKitInSkyrimReplay
+		static inline bool CaptureEnabled = false;
+
+		// [Stats] bShowPanel: PerfCounters summary in the top left corner of the overlay
+		static inline bool StatsPanel = true;
+		// [Stats] iLogIntervalMS: how often the summary is written to the log, 0 never
+		static inline std::uint32_t StatsLogIntervalMS = 10000;
+
+		// [Budget] iMaxLines, iMaxMicroseconds, fMinScreenLength: see FrameBudget, 0 is unlimited
+		static inline FrameBudget Budget{ 30000, 3000, 1.0f };
+
+		// [Skeletons] bDraw: draws the bones of every actor near the camera, see SkeletonCache
+		static inline bool SkeletonOverlay = false;
+
+		// [Navmesh] bAnalyze: checks every navmesh as its cell loads and highlights broken triangles, see
+		// NavmeshAnalyzer. The findings are logged
+		static inline bool NavmeshAnalyze = true;
+		// [Navmesh] bActorPaths: draws the navmesh path from every loaded actor near the player to the player, see
+		// NavmeshGraph
+		static inline bool NavmeshActorPaths = false;
+		// [Navmesh] bExport: writes the navmeshes of the loaded cells to CreationKitInSkyrim.<world>.navmesh next to
+		// the log, see NavmeshExporter
+		static inline bool NavmeshExport = false;
 	};
 
 	class DebugAPI
@@ -94,16 +130,52 @@ namespace DebugAPI_IMPL
 			float lineThickness = 1);
 		static void DrawCircle(glm::vec3, float radius, glm::vec3 eulerAngles, int liftetimeMS = 10,
 			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
+		static void DrawCapsule(glm::vec3 from, glm::vec3 to, float radius, int liftetimeMS = 10,
+			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
+		static void DrawBox(glm::vec3 center, glm::vec3 halfExtents, glm::vec3 eulerAngles, int liftetimeMS = 10,
+			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
+		static void DrawCone(glm::vec3 apex, glm::vec3 baseCenter, float radius, int liftetimeMS = 10,
+			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
+		static void DrawArrow(glm::vec3 from, glm::vec3 to, float headSize, int liftetimeMS = 10,
+			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
+
+		// batched versions of DrawLineForMS. DrawLinesForMS takes pairs of points, DrawPolylineForMS connects
+		// consecutive points (and the last to the first if closed)
+		static void DrawLinesForMS(std::span<const glm::vec3> segmentPoints, int liftetimeMS = 10,
+			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
+		static void DrawPolylineForMS(std::span<const glm::vec3> points, bool closed, int liftetimeMS = 10,
+			const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f }, float lineThickness = 1);
 
-		static std::mutex LinesToDraw_mutex;
-		static std::vector<DebugAPILine*> LinesToDraw;
+		// DrawLinesForMS for geometry that stays put: the lines are drawn every frame until Renderer.DestroyBatch,
+		// without being submitted again. segmentPoints are in the local space of transform. The handle moves, hides and
+		// recolors them through Renderer, see LineRenderer::CreateBatch
+		static LineRenderer::BatchHandle CreateLineBatch(std::span<const glm::vec3> segmentPoints,
+			const glm::mat4& transform = glm::mat4(1.0f), const glm::vec4& color = { 1.0f, 0.0f, 0.0f, 1.0f },
+			float lineThickness = 1);
 
-		static bool DEBUG_API_REGISTERED;
+		// circle segment count for the projected size of a circle, between Shapes::MIN_CIRCLE_SEGMENTS for far away
+		// ones and Shapes::MAX_CIRCLE_SEGMENTS for close ones
+		static std::uint32_t GetCircleSegments(const glm::vec3& center, float radius);
+
+		// DrawLineForMS only submits to the renderer, Update hands it the camera and the movie once per frame
+		static LineRenderer Renderer;
+
+		// records every frame from now on, see LineRenderer::StartCapture
+		static void StartCapture();
+
+		// refreshes the stats panel and writes the counters to the log, each at most every so often
+		static void UpdateStats(RE::GPtr<RE::GFxMovieView> movie, std::uint64_t now);
+
+		static constexpr std::uint64_t STATS_PANEL_INTERVAL_MS = 250;
+		static constexpr const char* STATS_PANEL_NAME = "debugAPIStats";
+		static constexpr const char* STATS_PANEL_PATH = "_root.debugAPIStats";
 
-		static constexpr int CIRCLE_NUM_SEGMENTS = 32;
+		static bool DEBUG_API_REGISTERED;
 
 		static constexpr float DRAW_LOC_MAX_DIF = 5.0f;
 
+		static CameraSnapshot CaptureCamera(RE::GPtr<RE::GFxMovieView> movie);
+		static void PublishLodCamera(const CameraSnapshot& camera);
 		static glm::vec2 WorldToScreenLoc(RE::GPtr<RE::GFxMovieView> movie, glm::vec3 worldLoc);
 		static float RGBToHex(glm::vec3 rgb);
 
@@ -126,17 +198,31 @@ namespace DebugAPI_IMPL
 		static float ConvertComponentR(float value);
 		static float ConvertComponentG(float value);
 		static float ConvertComponentB(float value);
-		// returns true if there is already a line with the same color at around the same from and to position
-		// with some leniency to bundle together lines in roughly the same spot (see DRAW_LOC_MAX_DIF)
-		static DebugAPILine* GetExistingLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color,
+		static LineCommand MakeCommand(const glm::vec3& from, const glm::vec3& to, int liftetimeMS, std::uint32_t color,
 			float lineThickness);
+
+		// the last frame's camera, for picking level of detail on the submitting thread. Relaxed atomics, a torn read
+		// only picks a slightly off segment count
+		struct LodCamera
+		{
+			std::atomic<float> X{ 0.0f };
+			std::atomic<float> Y{ 0.0f };
+			std::atomic<float> Z{ 0.0f };
+			// on-screen pixels of one world unit at a distance of one unit
+			std::atomic<float> FocalPixels{ 0.0f };
+		};
+		static LodCamera Lod;
 	};
 
+	// the plugin's own always open menu, its movie (interface/overlay_menu) implements drawPolylines for DrawList.
+	// Without Data/Interface/CreationKitInSkyrim/overlay_menu.swf installed the overlay draws into the vanilla HUD with
+	// one Invoke per segment instead
 	class DebugOverlayMenu : RE::IMenu
 	{
 	public:
-		static constexpr const char* MENU_PATH = "BetterThirdPersonSelection/overlay_menu";
-		static constexpr const char* MENU_NAME = "HUD Menu";
+		static constexpr const char* MENU_PATH = "CreationKitInSkyrim/overlay_menu";
+		static constexpr const char* MENU_NAME = "CreationKitInSkyrimOverlay";
+		static constexpr const char* HUD_MENU_NAME = "HUD Menu";
 
 		DebugOverlayMenu();
 
@@ -144,30 +230,69 @@ namespace DebugAPI_IMPL
 
 		static void Show();
 		static void Hide();
+		// logs the movie's repeat and drop counts that are still pending, see Logger::FlushPending
+		static void FlushLog() { Logger::FlushPending(); }
 
 		static RE::stl::owner<RE::IMenu*> Creator() { return new DebugOverlayMenu(); }
 
 		void AdvanceMovie(float a_interval, std::uint32_t a_currentTime) override;
 
 	private:
+		// the movie's trace output. Formats into a per-thread buffer and hands the message to an async logger sharing
+		// the plugin log's sinks, so a chatty movie never waits on the disk. Repeats of the previous message are
+		// coalesced, and every thread logs at most MAX_MESSAGES_PER_SECOND, the rest are only counted. The counts are
+		// logged with the thread's next message, by FlushPending, when the thread exits or at shutdown
 		class Logger : public RE::GFxLog
 		{
 		public:
-			void LogMessageVarg(LogMessageType, const char* a_fmt, std::va_list a_argList) override
+			static constexpr std::string_view LOG_NAME = "scaleform";
+			// spdlog's async records keep the logger name and the message in a buffer of this size, longer ones go to
+			// the heap (see spdlog::memory_buf_t)
+			static constexpr std::size_t INLINE_RECORD_SIZE = 250;
+			// longer messages are cut off, so queuing one never allocates
+			static constexpr std::size_t MAX_MESSAGE_LENGTH = INLINE_RECORD_SIZE - LOG_NAME.size();
+			static constexpr std::uint32_t MAX_MESSAGES_PER_SECOND = 50;
+			// messages queued for the log thread, if it falls behind the oldest are overwritten
+			static constexpr std::size_t ASYNC_QUEUE_SIZE = 8192;
+			static constexpr auto FLUSH_INTERVAL = std::chrono::seconds(1);
+
+			void LogMessageVarg(LogMessageType, const char* a_fmt, std::va_list a_argList) override;
+
+			// logs the pending counts of every thread, at most once per FLUSH_INTERVAL. Cheap to call every frame
+			static void FlushPending();
+
+		private:
+			struct ThreadState
 			{
-				std::string fmt(a_fmt ? a_fmt : "");
-				while (!fmt.empty() && fmt.back() == '\n') {
-					fmt.pop_back();
-				}
+				ThreadState();
+				// logs what is still pending
+				~ThreadState();
 
-				std::va_list args;
-				va_copy(args, a_argList);
-				std::vector<char> buf(static_cast<std::size_t>(std::vsnprintf(0, 0, fmt.c_str(), a_argList) + 1));
-				std::vsnprintf(buf.data(), buf.size(), fmt.c_str(), args);
-				va_end(args);
+				char Buffer[MAX_MESSAGE_LENGTH];
+				char Last[MAX_MESSAGE_LENGTH];
+				std::size_t LastLength = 0;
 
-				logger::info("{}"sv, buf.data());
-			}
+				std::chrono::steady_clock::time_point SecondStart;
+				std::uint32_t SecondCount = 0;
+
+				// taken by FlushPending from other threads
+				std::atomic<std::uint32_t> Repeats{ 0 };
+				std::atomic<std::uint32_t> Dropped{ 0 };
+			};
+
+			// every live ThreadState, flushes them once more on shutdown
+			struct Registry
+			{
+				~Registry();
+
+				std::mutex Mutex;
+				std::vector<ThreadState*> States;
+				std::atomic<std::int64_t> NextFlush{ 0 };
+			};
+
+			static spdlog::logger& GetLog();
+			static Registry& GetRegistry();
+			static void LogPending(ThreadState& state);
 		};
 	};
 
@@ -220,158 +345,209 @@ using namespace DebugAPI_IMPL::DrawDebug;
 
 namespace DebugAPI_IMPL
 {
-	glm::highp_mat4 GetRotationMatrix(glm::vec3 eulerAngles)
+	glm::vec3 RotMatrixToEuler(RE::NiMatrix3 matrixIn)
 	{
-		return glm::eulerAngleXYZ(-(eulerAngles.x), -(eulerAngles.y), -(eulerAngles.z));
-	}
+		auto ent = matrixIn.entry;
+		auto rotMat =
+			glm::mat4({ ent[0][0], ent[1][0], ent[2][0], ent[0][1], ent[1][1], ent[2][1], ent[0][2], ent[1][2], ent[2][2] });
 
-	glm::vec3 NormalizeVector(glm::vec3 p) { return glm::normalize(p); }
+		glm::vec3 rotOut;
+		glm::extractEulerAngleXYZ(rotMat, rotOut.x, rotOut.y, rotOut.z);
 
-	glm::vec3 RotateVector(glm::quat quatIn, glm::vec3 vecIn)
-	{
-		float num = quatIn.x * 2.0f;
-		float num2 = quatIn.y * 2.0f;
-		float num3 = quatIn.z * 2.0f;
-		float num4 = quatIn.x * num;
-		float num5 = quatIn.y * num2;
-		float num6 = quatIn.z * num3;
-		float num7 = quatIn.x * num2;
-		float num8 = quatIn.x * num3;
-		float num9 = quatIn.y * num3;
-		float num10 = quatIn.w * num;
-		float num11 = quatIn.w * num2;
-		float num12 = quatIn.w * num3;
-		glm::vec3 result;
-		result.x = (1.0f - (num5 + num6)) * vecIn.x + (num7 - num12) * vecIn.y + (num8 + num11) * vecIn.z;
-		result.y = (num7 + num12) * vecIn.x + (1.0f - (num4 + num6)) * vecIn.y + (num9 - num10) * vecIn.z;
-		result.z = (num8 - num11) * vecIn.x + (num9 + num10) * vecIn.y + (1.0f - (num4 + num5)) * vecIn.z;
-		return result;
+		return rotOut;
 	}
 
-	glm::vec3 RotateVector(glm::vec3 eulerIn, glm::vec3 vecIn)
+	constexpr int FIND_COLLISION_MAX_RECURSION = 2;
+
+	// the skeleton nodes of references, looked up by name once per loaded 3D instead of on every call. Entries hold
+	// their nodes, so a cached pointer can't dangle or be reused by a different 3D. Update drops the entries whose
+	// reference is gone or whose 3D was reloaded or unloaded, which releases the old nodes
+	class SkeletonCache
 	{
-		glm::vec3 glmVecIn(vecIn.x, vecIn.y, vecIn.z);
-		glm::mat3 rotationMatrix = glm::eulerAngleXYZ(eulerIn.x, eulerIn.y, eulerIn.z);
+	public:
+		enum Node : std::uint32_t
+		{
+			kSpine,
+			kHead,
 
-		return rotationMatrix * glmVecIn;
-	}
+			kNodeCount
+		};
 
-	glm::vec3 GetForwardVector(glm::quat quatIn)
-	{
-		// rotate Skyrim's base forward vector (positive Y forward) by quaternion
-		return RotateVector(quatIn, glm::vec3(0.0f, 1.0f, 0.0f));
-	}
+		// bones of one actor the overlay draws at most
+		static constexpr std::size_t MAX_BONES = 256;
+		static constexpr float OVERLAY_RADIUS = 4096.0f;
 
-	glm::vec3 GetForwardVector(glm::vec3 eulerIn)
-	{
-		float pitch = eulerIn.x;
-		float yaw = eulerIn.z;
+		static SkeletonCache& GetSingleton()
+		{
+			static SkeletonCache cache;
+			return cache;
+		}
 
-		return glm::vec3(sin(yaw) * cos(pitch), cos(yaw) * cos(pitch), sin(pitch));
-	}
+		// null if object isn't an actor, has no 3D, isn't an NPC or its skeleton doesn't have the node. Only actors are
+		// cached, anything else the callers pass (markers, statics) would pile up until its 3D unloads
+		RE::NiPointer<RE::NiAVObject> GetNode(RE::TESObjectREFR* object, Node node);
 
-	glm::vec3 GetRightVector(glm::quat quatIn)
-	{
-		// rotate Skyrim's base right vector (positive X forward) by quaternion
-		return RotateVector(quatIn, glm::vec3(1.0f, 0.0f, 0.0f));
-	}
+		// once per frame: prunes, then submits the bones of every actor within OVERLAY_RADIUS of center in one batch
+		void Update(const glm::vec3& center, bool drawSkeletons);
 
-	glm::vec3 GetRightVector(glm::vec3 eulerIn)
-	{
-		float pitch = eulerIn.x;
-		float yaw = eulerIn.z + glm::half_pi<float>();
+	private:
+		static constexpr std::uint32_t NO_PARENT = ~0u;
 
-		return glm::vec3(sin(yaw) * cos(pitch), cos(yaw) * cos(pitch), sin(pitch));
-	}
+		struct Skeleton
+		{
+			RE::ObjectRefHandle Handle;
+			RE::NiPointer<RE::NiAVObject> Root;
+			std::array<RE::NiPointer<RE::NiAVObject>, kNodeCount> Nodes;
+
+			// collected the first time the overlay draws the actor. Parents are indices into Bones
+			bool HasBones = false;
+			std::vector<RE::NiPointer<RE::NiAVObject>> Bones;
+			std::vector<std::uint32_t> Parents;
+		};
 
-	glm::vec3 ThreeAxisRotation(float r11, float r12, float r21, float r31, float r32)
-	{
-		return glm::vec3(asin(r21), atan2(r11, r12), atan2(-r31, r32));
-	}
+		// the entry for object's current 3D, resolved if there is none yet or the 3D changed. Called with Mutex held
+		Skeleton* Resolve(RE::TESObjectREFR* object);
+		static void CollectBones(Skeleton& skeleton);
+		void AddBones(Skeleton& skeleton);
 
-	glm::vec3 RotMatrixToEuler(RE::NiMatrix3 matrixIn)
-	{
-		auto ent = matrixIn.entry;
-		auto rotMat =
-			glm::mat4({ ent[0][0], ent[1][0], ent[2][0], ent[0][1], ent[1][1], ent[2][1], ent[0][2], ent[1][2], ent[2][2] });
+		std::mutex Mutex;
+		std::unordered_map<RE::FormID, Skeleton> Skeletons;
+		std::vector<LineCommand> Lines;
+	};
 
-		glm::vec3 rotOut;
-		glm::extractEulerAngleXYZ(rotMat, rotOut.x, rotOut.y, rotOut.z);
+	RE::NiPointer<RE::NiAVObject> SkeletonCache::GetNode(RE::TESObjectREFR* object, Node node)
+	{
+		if (!object || !object->As<RE::Actor>())
+			return nullptr;
 
-		return rotOut;
+		std::lock_guard<std::mutex> lg(Mutex);
+		auto skeleton = Resolve(object);
+		return skeleton ? skeleton->Nodes[node] : nullptr;
 	}
 
-	constexpr int FIND_COLLISION_MAX_RECURSION = 2;
-
-	RE::NiAVObject* GetCharacterSpine(RE::TESObjectREFR* object)
+	SkeletonCache::Skeleton* SkeletonCache::Resolve(RE::TESObjectREFR* object)
 	{
-		auto characterObject = object->GetObjectReference()->As<RE::TESNPC>();
-		auto mesh = object->GetCurrent3D();
-
-		if (characterObject && mesh) {
-			auto spineNode = mesh->GetObjectByName("NPC Spine [Spn0]");
-			if (spineNode)
-				return spineNode;
+		auto root = object->GetCurrent3D();
+		if (!root) {
+			Skeletons.erase(object->GetFormID());
+			return nullptr;
 		}
 
-		return mesh;
-	}
+		auto& skeleton = Skeletons[object->GetFormID()];
+		if (skeleton.Root.get() == root)
+			return &skeleton;
 
-	RE::NiAVObject* GetCharacterHead(RE::TESObjectREFR* object)
-	{
-		auto characterObject = object->GetObjectReference()->As<RE::TESNPC>();
-		auto mesh = object->GetCurrent3D();
+		skeleton = Skeleton();
+		skeleton.Handle = object->GetHandle();
+		skeleton.Root.reset(root);
 
-		if (characterObject && mesh) {
-			auto spineNode = mesh->GetObjectByName("NPC Head [Head]");
-			if (spineNode)
-				return spineNode;
+		if (object->GetObjectReference()->As<RE::TESNPC>()) {
+			skeleton.Nodes[kSpine].reset(root->GetObjectByName("NPC Spine [Spn0]"));
+			skeleton.Nodes[kHead].reset(root->GetObjectByName("NPC Head [Head]"));
 		}
 
-		return mesh;
+		return &skeleton;
 	}
 
-	bool IsRoughlyEqual(float first, float second, float maxDif) { return abs(first - second) <= maxDif; }
-
-	glm::vec3 QuatToEuler(glm::quat q)
+	void SkeletonCache::CollectBones(Skeleton& skeleton)
 	{
-		auto matrix = glm::toMat4(q);
+		skeleton.HasBones = true;
 
-		glm::vec3 rotOut;
-		glm::extractEulerAngleXYZ(matrix, rotOut.x, rotOut.y, rotOut.z);
+		// depth first over the named nodes below the root, each one's parent is its closest named ancestor
+		std::vector<std::pair<RE::NiAVObject*, std::uint32_t>> pending{ { skeleton.Root.get(), NO_PARENT } };
+		while (!pending.empty() && skeleton.Bones.size() < MAX_BONES) {
+			const auto [object, parent] = pending.back();
+			pending.pop_back();
 
-		return rotOut;
+			auto node = object->AsNode();
+			if (!node)
+				continue;
+
+			auto index = parent;
+			if (object != skeleton.Root.get() && !object->name.empty()) {
+				index = static_cast<std::uint32_t>(skeleton.Bones.size());
+				skeleton.Bones.emplace_back(object);
+				skeleton.Parents.push_back(parent);
+			}
+
+			for (auto& child : node->children) {
+				if (child) {
+					pending.emplace_back(child.get(), index);
+				}
+			}
+		}
 	}
 
-	glm::quat EulerToQuat(glm::vec3 rotIn)
+	void SkeletonCache::AddBones(Skeleton& skeleton)
 	{
-		auto matrix = glm::eulerAngleXYZ(rotIn.x, rotIn.y, rotIn.z);
-		return glm::toQuat(matrix);
+		if (!skeleton.HasBones) {
+			CollectBones(skeleton);
+		}
+
+		static const auto BONE_COLOR = DebugAPILine::PackColor({ 0.9f, 0.9f, 0.9f, 1.0f });
+
+		for (std::size_t i = 0; i < skeleton.Bones.size(); i++) {
+			if (skeleton.Parents[i] == NO_PARENT)
+				continue;
+
+			const auto& from = skeleton.Bones[skeleton.Parents[i]]->world.translate;
+			const auto& to = skeleton.Bones[i]->world.translate;
+			Lines.push_back({ { from.x, from.y, from.z }, { to.x, to.y, to.z }, BONE_COLOR, 2.0f, LineCommand::TRANSIENT });
+		}
 	}
 
-	glm::vec3 GetInverseRotation(glm::vec3 rotIn)
+	void SkeletonCache::Update(const glm::vec3& center, bool drawSkeletons)
 	{
-		auto matrix = glm::eulerAngleXYZ(rotIn.y, rotIn.x, rotIn.z);
-		auto inverseMatrix = glm::inverse(matrix);
+		ScopedPerfTimer timer(DebugAPI::Renderer.GetCounters(), PerfCounters::kSkeletons);
+		std::lock_guard<std::mutex> lg(Mutex);
 
-		glm::vec3 rotOut;
-		glm::extractEulerAngleYXZ(inverseMatrix, rotOut.x, rotOut.y, rotOut.z);
-		return rotOut;
-	}
+		std::erase_if(Skeletons, [](const auto& entry) {
+			auto object = entry.second.Handle.get();
+			return !object || object->GetCurrent3D() != entry.second.Root.get();
+		});
 
-	glm::quat GetInverseRotation(glm::quat rotIn) { return glm::inverse(rotIn); }
+		if (!drawSkeletons)
+			return;
 
-	glm::vec3 EulerRotationToVector(glm::vec3 rotIn)
-	{
-		return glm::vec3(cos(rotIn.y) * cos(rotIn.x), sin(rotIn.y) * cos(rotIn.x), sin(rotIn.x));
+		Lines.clear();
+
+		auto addActor = [&](RE::Actor* actor) {
+			const auto position = actor->GetPosition();
+			if (glm::distance(glm::vec3(position.x, position.y, position.z), center) > OVERLAY_RADIUS)
+				return;
+
+			if (auto skeleton = Resolve(actor)) {
+				AddBones(*skeleton);
+			}
+		};
+
+		if (auto player = RE::PlayerCharacter::GetSingleton()) {
+			addActor(player);
+		}
+
+		if (auto processLists = RE::ProcessLists::GetSingleton()) {
+			for (auto& handle : processLists->highActorHandles) {
+				if (auto actor = handle.get()) {
+					addActor(actor.get());
+				}
+			}
+		}
+
+		if (!Lines.empty()) {
+			DebugAPI::Renderer.Submit(Lines);
+		}
 	}
 
-	glm::vec3 VectorToEulerRotation(glm::vec3 vecIn)
+	RE::NiAVObject* GetCharacterSpine(RE::TESObjectREFR* object)
 	{
-		float yaw = atan2(vecIn.x, vecIn.y);
-		float pitch = atan2(vecIn.z, sqrt((vecIn.x * vecIn.x) + (vecIn.y * vecIn.y)));
+		auto spineNode = SkeletonCache::GetSingleton().GetNode(object, SkeletonCache::kSpine);
+		return spineNode ? spineNode.get() : object->GetCurrent3D();
+	}
 
-		return glm::vec3(pitch, 0.0f, yaw);
+	RE::NiAVObject* GetCharacterHead(RE::TESObjectREFR* object)
+	{
+		auto headNode = SkeletonCache::GetSingleton().GetNode(object, SkeletonCache::kHead);
+		return headNode ? headNode.get() : object->GetCurrent3D();
 	}
 
 	glm::vec3 GetCameraPos()
@@ -394,32 +570,6 @@ namespace DebugAPI_IMPL
 		return glm::quat(niRotation.w, niRotation.x, niRotation.y, niRotation.z);
 	}
 
-	bool IsPosBehindPlayerCamera(glm::vec3 pos)
-	{
-		auto cameraPos = GetCameraPos();
-		auto cameraRot = GetCameraRot();
-
-		auto toTarget = NormalizeVector(pos - cameraPos);
-		auto cameraForward = NormalizeVector(GetForwardVector(cameraRot));
-
-		auto angleDif = abs(glm::length(toTarget - cameraForward));
-
-		// root_two is the diagonal length of a 1x1 square. When comparing normalized forward
-		// vectors, this accepts an angle of 90 degrees in all directions
-		return angleDif > glm::root_two<float>();
-	}
-
-	glm::vec3 GetPointOnRotatedCircle(glm::vec3 origin, float radius, float i, float maxI, glm::vec3 eulerAngles)
-	{
-		float currAngle = (i / maxI) * glm::two_pi<float>();
-
-		glm::vec3 targetPos((radius * cos(currAngle)), (radius * sin(currAngle)), 0.0f);
-
-		auto targetPosRotated = RotateVector(eulerAngles, targetPos);
-
-		return glm::vec3(targetPosRotated.x + origin.x, targetPosRotated.y + origin.y, targetPosRotated.z + origin.z);
-	}
-
 	glm::vec3 GetObjectAccuratePosition(RE::TESObjectREFR* object)
 	{
 		auto mesh = object->GetCurrent3D();
@@ -434,65 +584,220 @@ namespace DebugAPI_IMPL
 		return glm::vec3(niPos.x, niPos.y, niPos.z);
 	}
 
-	std::mutex DebugAPI::LinesToDraw_mutex;
-	std::vector<DebugAPILine*> DebugAPI::LinesToDraw;
+	LineRenderer DebugAPI::Renderer(DebugAPI::DRAW_LOC_MAX_DIF);
+	DebugAPI::LodCamera DebugAPI::Lod;
 
 	bool DebugAPI::CachedMenuData;
 
 	float DebugAPI::ScreenResX;
 	float DebugAPI::ScreenResY;
 
-	DebugAPILine::DebugAPILine(glm::vec3 from, glm::vec3 to, glm::vec4 color, float lineThickness,
-		unsigned __int64 destroyTickCount)
+	class GFxOverlayMovie : public OverlayMovie
+	{
+	public:
+		static constexpr const char* DRAW_LIST_FUNCTION = "drawPolylines";
+
+		explicit GFxOverlayMovie(RE::GPtr<RE::GFxMovieView> movie) :
+			Movie(std::move(movie))
+		{}
+
+		bool SupportsDrawList() const override { return Movie->IsAvailable(DRAW_LIST_FUNCTION); }
+
+		void Invoke(const char* method, const float* args, std::uint32_t argCount) override
+		{
+			assert(argCount <= MAX_INVOKE_ARGS);
+			argCount = std::min(argCount, MAX_INVOKE_ARGS);
+
+			RE::GFxValue values[MAX_INVOKE_ARGS];
+			for (std::uint32_t i = 0; i < argCount; i++) {
+				values[i] = args[i];
+			}
+
+			Movie->Invoke(method, nullptr, argCount ? values : nullptr, argCount);
+			InvokeCount++;
+		}
+
+		void InvokeDrawList(const std::vector<float>& packed) override
+		{
+			RE::GFxValue array;
+			Movie->CreateArray(&array);
+			array.SetArraySize(static_cast<std::uint32_t>(packed.size()));
+			for (std::uint32_t i = 0; i < packed.size(); i++) {
+				array.SetElement(i, RE::GFxValue(packed[i]));
+			}
+
+			Movie->Invoke(DRAW_LIST_FUNCTION, nullptr, &array, 1);
+			InvokeCount++;
+		}
+
+	private:
+		RE::GPtr<RE::GFxMovieView> Movie;
+	};
+
+	LineCommand DebugAPI::MakeCommand(const glm::vec3& from, const glm::vec3& to, int liftetimeMS, std::uint32_t color,
+		float lineThickness)
 	{
-		From = from;
-		To = to;
-		Color = color;
-		fColor = DebugAPI::RGBToHex(color);
-		Alpha = color.a * 100.0f;
-		LineThickness = lineThickness;
-		DestroyTickCount = destroyTickCount;
+		LineCommand command;
+		command.From = from;
+		command.To = to;
+		command.Color = color;
+		command.Thickness = lineThickness;
+		command.DestroyTickCount = liftetimeMS == 0 ? LineCommand::TRANSIENT : GetTickCount64() + liftetimeMS;
+		return command;
 	}
 
 	void DebugAPI::DrawLineForMS(const glm::vec3& from, const glm::vec3& to, int liftetimeMS, const glm::vec4& color,
 		float lineThickness)
 	{
-		DebugAPILine* oldLine = GetExistingLine(from, to, color, lineThickness);
-		if (oldLine) {
-			oldLine->From = from;
-			oldLine->To = to;
-			oldLine->DestroyTickCount = GetTickCount64() + liftetimeMS;
-			oldLine->LineThickness = lineThickness;
+		Renderer.Submit(MakeCommand(from, to, liftetimeMS, DebugAPILine::PackColor(color), lineThickness));
+	}
+
+	void DebugAPI::DrawLinesForMS(std::span<const glm::vec3> segmentPoints, int liftetimeMS, const glm::vec4& color,
+		float lineThickness)
+	{
+		thread_local std::vector<LineCommand> commands;
+		commands.clear();
+
+		// one tick count and color conversion for the whole batch
+		const auto first = MakeCommand({}, {}, liftetimeMS, DebugAPILine::PackColor(color), lineThickness);
+		for (std::size_t i = 0; i + 1 < segmentPoints.size(); i += 2) {
+			auto& command = commands.emplace_back(first);
+			command.From = segmentPoints[i];
+			command.To = segmentPoints[i + 1];
+		}
+
+		Renderer.Submit(commands);
+	}
+
+	void DebugAPI::DrawPolylineForMS(std::span<const glm::vec3> points, bool closed, int liftetimeMS, const glm::vec4& color,
+		float lineThickness)
+	{
+		if (points.size() < 2)
+			return;
+
+		thread_local std::vector<LineCommand> commands;
+		commands.clear();
+
+		const auto first = MakeCommand({}, {}, liftetimeMS, DebugAPILine::PackColor(color), lineThickness);
+		for (std::size_t i = closed ? 0 : 1; i < points.size(); i++) {
+			auto& command = commands.emplace_back(first);
+			command.From = points[i == 0 ? points.size() - 1 : i - 1];
+			command.To = points[i];
+		}
+
+		Renderer.Submit(commands);
+	}
+
+	LineRenderer::BatchHandle DebugAPI::CreateLineBatch(std::span<const glm::vec3> segmentPoints, const glm::mat4& transform,
+		const glm::vec4& color, float lineThickness)
+	{
+		std::vector<LineRenderer::BatchLine> lines;
+		lines.reserve(segmentPoints.size() / 2);
+
+		const auto packedColor = DebugAPILine::PackColor(color);
+		for (std::size_t i = 0; i + 1 < segmentPoints.size(); i += 2) {
+			lines.push_back({ segmentPoints[i], segmentPoints[i + 1], packedColor, lineThickness });
+		}
+
+		return Renderer.CreateBatch(lines, transform);
+	}
+
+	void Settings::Load()
+	{
+		const auto path = GetPath();
+
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		if (ini.LoadFile(path.c_str()) < 0) {
+			logger::info(FMT_STRING("{} not found, using the default settings"), path);
+			return;
+		}
+
+		CaptureEnabled = ini.GetBoolValue("Capture", "bEnabled", CaptureEnabled);
+
+		StatsPanel = ini.GetBoolValue("Stats", "bShowPanel", StatsPanel);
+		StatsLogIntervalMS = static_cast<std::uint32_t>(ini.GetLongValue("Stats", "iLogIntervalMS", StatsLogIntervalMS));
+
+		auto getUInt = [&ini](const char* section, const char* key, std::uint32_t value) {
+			return static_cast<std::uint32_t>(ini.GetLongValue(section, key, value));
+		};
+
+		Budget.MaxLines = getUInt("Budget", "iMaxLines", Budget.MaxLines);
+		Budget.MaxMicroseconds = getUInt("Budget", "iMaxMicroseconds", Budget.MaxMicroseconds);
+		Budget.MinScreenLength = static_cast<float>(ini.GetDoubleValue("Budget", "fMinScreenLength", Budget.MinScreenLength));
+
+		SkeletonOverlay = ini.GetBoolValue("Skeletons", "bDraw", SkeletonOverlay);
+
+		NavmeshAnalyze = ini.GetBoolValue("Navmesh", "bAnalyze", NavmeshAnalyze);
+		NavmeshActorPaths = ini.GetBoolValue("Navmesh", "bActorPaths", NavmeshActorPaths);
+		NavmeshExport = ini.GetBoolValue("Navmesh", "bExport", NavmeshExport);
+	}
+
+	void DebugAPI::StartCapture()
+	{
+		auto path = logger::log_directory();
+		if (!path)
+			return;
+
+		*path /= Version::PROJECT;
+		*path += ".capture"sv;
+		if (!Renderer.StartCapture(*path)) {
+			logger::error(FMT_STRING("couldn't create {}"), path->string());
 			return;
 		}
 
-		DebugAPILine* newLine = new DebugAPILine(from, to, color, lineThickness, GetTickCount64() + liftetimeMS);
-		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
-		LinesToDraw.push_back(newLine);
+		logger::info(FMT_STRING("capturing the overlay to {}"), path->string());
 	}
 
 	void DebugAPI::Update()
 	{
 		auto hud = GetHUD();
-		if (!hud || !hud->uiMovie)
+		if (!hud || !hud->uiMovie) {
+			Renderer.SkipFrame(GetTickCount64());
 			return;
+		}
 
 		CacheMenuData();
-		ClearLines2D(hud->uiMovie);
 
-		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
-		for (int i = 0; i < LinesToDraw.size(); i++) {
-			DebugAPILine* line = LinesToDraw[i];
+		GFxOverlayMovie movie(hud->uiMovie);
 
-			DrawLine3D(hud->uiMovie, line->From, line->To, line->fColor, line->LineThickness, line->Alpha);
+		const CameraSnapshot camera = CaptureCamera(hud->uiMovie);
+		PublishLodCamera(camera);
 
-			if (GetTickCount64() > line->DestroyTickCount) {
-				LinesToDraw.erase(LinesToDraw.begin() + i);
-				delete line;
+		const auto now = GetTickCount64();
+		Renderer.RenderFrame(camera, now, movie);
 
-				i--;
-				continue;
+		UpdateStats(hud->uiMovie, now);
+	}
+
+	void DebugAPI::UpdateStats(RE::GPtr<RE::GFxMovieView> movie, std::uint64_t now)
+	{
+		// due times are claimed with a compare exchange, so a second caller in the same interval does nothing
+		auto isDue = [now](std::atomic<std::uint64_t>& next, std::uint64_t interval) {
+			auto due = next.load(std::memory_order_relaxed);
+			return now >= due && next.compare_exchange_strong(due, now + interval, std::memory_order_relaxed);
+		};
+
+		static std::atomic<std::uint64_t> nextPanelUpdate = 0;
+		if (Settings::StatsPanel && isDue(nextPanelUpdate, STATS_PANEL_INTERVAL_MS)) {
+			RE::GFxValue panel;
+			if (!movie->GetVariable(&panel, STATS_PANEL_PATH) || panel.IsUndefined()) {
+				// name, depth, x, y, width, height
+				RE::GFxValue args[6] = { STATS_PANEL_NAME, 16384.0, 16.0, 16.0, 640.0, 72.0 };
+				movie->Invoke("_root.createTextField", nullptr, args, 6);
+				movie->SetVariable("_root.debugAPIStats.selectable", RE::GFxValue(false));
+				movie->SetVariable("_root.debugAPIStats.background", RE::GFxValue(true));
+				movie->SetVariable("_root.debugAPIStats.backgroundColor", RE::GFxValue(0.0));
+				movie->SetVariable("_root.debugAPIStats.textColor", RE::GFxValue(static_cast<double>(0xffffff)));
 			}
+
+			const auto text = Renderer.GetCounters().Format();
+			movie->SetVariable("_root.debugAPIStats.text", RE::GFxValue(text.c_str()));
+		}
+
+		static std::atomic<std::uint64_t> nextLogDump = 0;
+		if (Settings::StatsLogIntervalMS && isDue(nextLogDump, Settings::StatsLogIntervalMS)) {
+			logger::info(FMT_STRING("overlay stats\n{}"), Renderer.GetCounters().Format());
 		}
 	}
 
@@ -505,46 +810,174 @@ namespace DebugAPI_IMPL
 	void DebugAPI::DrawCircle(glm::vec3 origin, float radius, glm::vec3 eulerAngles, int liftetimeMS, const glm::vec4& color,
 		float lineThickness)
 	{
-		glm::vec3 lastEndPos =
-			GetPointOnRotatedCircle(origin, radius, CIRCLE_NUM_SEGMENTS, (float)(CIRCLE_NUM_SEGMENTS - 1), eulerAngles);
+		// same rotation as RotateVector, the circle lies in the rotated XY plane
+		const glm::mat3 rotation = glm::eulerAngleXYZ(eulerAngles.x, eulerAngles.y, eulerAngles.z);
+		const auto segments = GetCircleSegments(origin, radius);
+
+		thread_local std::vector<glm::vec3> points;
+		points.clear();
+		Shapes::AppendCircle(points, origin, rotation[0], rotation[1], radius, segments, segments);
 
-		for (int i = 0; i <= CIRCLE_NUM_SEGMENTS; i++) {
-			glm::vec3 currEndPos =
-				GetPointOnRotatedCircle(origin, radius, (float)i, (float)(CIRCLE_NUM_SEGMENTS - 1), eulerAngles);
+		DrawPolylineForMS(points, true, liftetimeMS, color, lineThickness);
+	}
+
+	void DebugAPI::DrawCapsule(glm::vec3 from, glm::vec3 to, float radius, int liftetimeMS, const glm::vec4& color,
+		float lineThickness)
+	{
+		const float length = glm::length(to - from);
+		if (length <= 0.0f) {
+			DrawSphere(from, radius, liftetimeMS, color, lineThickness);
+			return;
+		}
 
-			DrawLineForMS(lastEndPos, currEndPos, liftetimeMS, color, lineThickness);
+		const glm::vec3 axis = (to - from) / length;
+		glm::vec3 u, v;
+		Shapes::GetBasis(axis, u, v);
+
+		const auto segments = std::max(GetCircleSegments(from, radius), GetCircleSegments(to, radius));
+
+		thread_local std::vector<glm::vec3> points;
+		points.clear();
+
+		// rings around both ends
+		Shapes::AppendCircle(points, from, u, v, radius, segments, segments);
+		DrawPolylineForMS(points, true, liftetimeMS, color, lineThickness);
+		points.clear();
+		Shapes::AppendCircle(points, to, u, v, radius, segments, segments);
+		DrawPolylineForMS(points, true, liftetimeMS, color, lineThickness);
+
+		// half circles capping both ends, in two perpendicular planes
+		for (const auto& side : { u, v }) {
+			points.clear();
+			Shapes::AppendCircle(points, to, side, axis, radius, segments, segments / 2 + 1);
+			DrawPolylineForMS(points, false, liftetimeMS, color, lineThickness);
+			points.clear();
+			Shapes::AppendCircle(points, from, side, -axis, radius, segments, segments / 2 + 1);
+			DrawPolylineForMS(points, false, liftetimeMS, color, lineThickness);
+		}
 
-			lastEndPos = currEndPos;
+		points.clear();
+		for (const auto& offset : { u, -u, v, -v }) {
+			points.push_back(from + offset * radius);
+			points.push_back(to + offset * radius);
 		}
+		DrawLinesForMS(points, liftetimeMS, color, lineThickness);
 	}
 
-	DebugAPILine* DebugAPI::GetExistingLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color,
-		float lineThickness)
+	void DebugAPI::DrawBox(glm::vec3 center, glm::vec3 halfExtents, glm::vec3 eulerAngles, int liftetimeMS,
+		const glm::vec4& color, float lineThickness)
 	{
-		std::lock_guard<std::mutex> lg(LinesToDraw_mutex);
-		for (int i = 0; i < LinesToDraw.size(); i++) {
-			DebugAPILine* line = LinesToDraw[i];
+		const glm::mat3 rotation = glm::eulerAngleXYZ(eulerAngles.x, eulerAngles.y, eulerAngles.z);
+		const glm::vec3 x = rotation[0] * halfExtents.x;
+		const glm::vec3 y = rotation[1] * halfExtents.y;
+		const glm::vec3 z = rotation[2] * halfExtents.z;
+
+		// corner i has bit 0 set for +x, bit 1 for +y and bit 2 for +z
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; i++) {
+			corners[i] = center + ((i & 1) ? x : -x) + ((i & 2) ? y : -y) + ((i & 4) ? z : -z);
+		}
 
-			if (IsRoughlyEqual(from.x, line->From.x, DRAW_LOC_MAX_DIF) &&
-				IsRoughlyEqual(from.y, line->From.y, DRAW_LOC_MAX_DIF) &&
-				IsRoughlyEqual(from.z, line->From.z, DRAW_LOC_MAX_DIF) && IsRoughlyEqual(to.x, line->To.x, DRAW_LOC_MAX_DIF) &&
-				IsRoughlyEqual(to.y, line->To.y, DRAW_LOC_MAX_DIF) && IsRoughlyEqual(to.z, line->To.z, DRAW_LOC_MAX_DIF) &&
-				IsRoughlyEqual(lineThickness, line->LineThickness, DRAW_LOC_MAX_DIF) && color == line->Color) {
-				return line;
+		thread_local std::vector<glm::vec3> points;
+		points.clear();
+		for (int i = 0; i < 8; i++) {
+			for (int bit = 1; bit < 8; bit <<= 1) {
+				// every edge once, from the corner with the bit cleared
+				if (!(i & bit)) {
+					points.push_back(corners[i]);
+					points.push_back(corners[i | bit]);
+				}
 			}
 		}
 
-		return nullptr;
+		DrawLinesForMS(points, liftetimeMS, color, lineThickness);
+	}
+
+	void DebugAPI::DrawCone(glm::vec3 apex, glm::vec3 baseCenter, float radius, int liftetimeMS, const glm::vec4& color,
+		float lineThickness)
+	{
+		const float length = glm::length(apex - baseCenter);
+		if (length <= 0.0f)
+			return;
+
+		glm::vec3 u, v;
+		Shapes::GetBasis((apex - baseCenter) / length, u, v);
+
+		const auto segments = GetCircleSegments(baseCenter, radius);
+
+		thread_local std::vector<glm::vec3> points;
+		points.clear();
+		Shapes::AppendCircle(points, baseCenter, u, v, radius, segments, segments);
+		DrawPolylineForMS(points, true, liftetimeMS, color, lineThickness);
+
+		points.clear();
+		for (const auto& offset : { u, -u, v, -v }) {
+			points.push_back(apex);
+			points.push_back(baseCenter + offset * radius);
+		}
+		DrawLinesForMS(points, liftetimeMS, color, lineThickness);
+	}
+
+	void DebugAPI::DrawArrow(glm::vec3 from, glm::vec3 to, float headSize, int liftetimeMS, const glm::vec4& color,
+		float lineThickness)
+	{
+		const float length = glm::length(to - from);
+		if (length <= 0.0f)
+			return;
+
+		const glm::vec3 direction = (to - from) / length;
+		const float headLength = std::min(headSize, length);
+
+		DrawLineForMS(from, to, liftetimeMS, color, lineThickness);
+		DrawCone(to, to - direction * headLength, headLength * 0.5f, liftetimeMS, color, lineThickness);
+	}
+
+	std::uint32_t DebugAPI::GetCircleSegments(const glm::vec3& center, float radius)
+	{
+		const float focalPixels = Lod.FocalPixels.load(std::memory_order_relaxed);
+		if (focalPixels <= 0.0f)
+			return Shapes::DEFAULT_CIRCLE_SEGMENTS;
+
+		const glm::vec3 camera(Lod.X.load(std::memory_order_relaxed), Lod.Y.load(std::memory_order_relaxed),
+			Lod.Z.load(std::memory_order_relaxed));
+		const float distance = std::max(glm::length(center - camera), 1.0f);
+
+		const float screenRadius = std::abs(radius) * focalPixels / distance;
+		const float wanted = glm::two_pi<float>() * screenRadius / Shapes::CIRCLE_SEGMENT_PIXELS;
+
+		std::uint32_t segments = Shapes::MIN_CIRCLE_SEGMENTS;
+		while (segments < Shapes::MAX_CIRCLE_SEGMENTS && segments < wanted) {
+			segments *= 2;
+		}
+		return segments;
+	}
+
+	void DebugAPI::PublishLodCamera(const CameraSnapshot& camera)
+	{
+		// clip space y is the view space y times the focal length, and the view rotation rows are unit length
+		const auto& m = camera.WorldToCam;
+		const float focalLength = glm::length(glm::vec3(m[1][0], m[1][1], m[1][2]));
+		const float pixelsPerClipY =
+			std::abs((camera.RectBottom - camera.RectTop) * (camera.PortTop - camera.PortBottom) * 0.5f);
+
+		Lod.X.store(camera.Position.x, std::memory_order_relaxed);
+		Lod.Y.store(camera.Position.y, std::memory_order_relaxed);
+		Lod.Z.store(camera.Position.z, std::memory_order_relaxed);
+		Lod.FocalPixels.store(focalLength * pixelsPerClipY, std::memory_order_relaxed);
 	}
 
 	void DebugAPI::DrawLine3D(RE::GPtr<RE::GFxMovieView> movie, glm::vec3 from, glm::vec3 to, float color, float lineThickness,
 		float alpha)
 	{
-		if (IsPosBehindPlayerCamera(from) && IsPosBehindPlayerCamera(to))
+		const CameraSnapshot camera = CaptureCamera(movie);
+
+		glm::vec4 clipFrom = Projection::TransformToClip(camera, from);
+		glm::vec4 clipTo = Projection::TransformToClip(camera, to);
+		if (!Projection::ClipSegment(clipFrom, clipTo))
 			return;
 
-		glm::vec2 screenLocFrom = WorldToScreenLoc(movie, from);
-		glm::vec2 screenLocTo = WorldToScreenLoc(movie, to);
+		glm::vec2 screenLocFrom = Projection::ClipToScreen(camera, clipFrom);
+		glm::vec2 screenLocTo = Projection::ClipToScreen(camera, clipTo);
 		DrawLine2D(movie, screenLocFrom, screenLocTo, color, lineThickness, alpha);
 	}
 
@@ -592,8 +1025,11 @@ namespace DebugAPI_IMPL
 
 	RE::GPtr<RE::IMenu> DebugAPI::GetHUD()
 	{
-		RE::GPtr<RE::IMenu> hud = RE::UI::GetSingleton()->GetMenu(DebugOverlayMenu::MENU_NAME);
-		return hud;
+		auto ui = RE::UI::GetSingleton();
+		if (auto overlay = ui->GetMenu(DebugOverlayMenu::MENU_NAME); overlay && overlay->uiMovie)
+			return overlay;
+
+		return ui->GetMenu(DebugOverlayMenu::HUD_MENU_NAME);
 	}
 
 	float DebugAPI::RGBToHex(glm::vec3 rgb)
@@ -606,8 +1042,8 @@ namespace DebugAPI_IMPL
 	// the farther off screen even one line draw goes. I'm allowing some leeway, then I just clamp the
 	// coordinates to the screen rect.
 	//
-	// this is inaccurate. A more accurate solution would require finding the sub vector that overshoots the screen rect between
-	// two points and scale the vector accordingly. Might implement that at some point, but the inaccuracy is barely noticeable
+	// this is inaccurate, but only used for raw 2D lines. 3D lines are clipped exactly in clip space before they are
+	// projected (see Projection::ClipSegment)
 	const float CLAMP_MAX_OVERSHOOT = 10000.0f;
 	void DebugAPI::FastClampToScreen(glm::vec2& point)
 	{
@@ -638,6 +1074,27 @@ namespace DebugAPI_IMPL
 
 	float DebugAPI::ConvertComponentB(float value) { return value; }
 
+	CameraSnapshot DebugAPI::CaptureCamera(RE::GPtr<RE::GFxMovieView> movie)
+	{
+		CameraSnapshot snapshot;
+		snapshot.Position = GetCameraPos();
+		std::memcpy(snapshot.WorldToCam, reinterpret_cast<const void*>(REL::ID(519579).address()), sizeof(snapshot.WorldToCam));
+
+		const auto& port = *reinterpret_cast<const RE::NiRect<float>*>(REL::ID(519618).address());
+		snapshot.PortLeft = port.left;
+		snapshot.PortRight = port.right;
+		snapshot.PortTop = port.top;
+		snapshot.PortBottom = port.bottom;
+
+		RE::GRectF rect = movie->GetVisibleFrameRect();
+		snapshot.RectLeft = rect.left;
+		snapshot.RectRight = rect.right;
+		snapshot.RectTop = rect.top;
+		snapshot.RectBottom = rect.bottom;
+
+		return snapshot;
+	}
+
 	glm::vec2 DebugAPI::WorldToScreenLoc(RE::GPtr<RE::GFxMovieView> movie, glm::vec3 worldLoc)
 	{
 		glm::vec2 screenLocOut;
@@ -645,6 +1102,7 @@ namespace DebugAPI_IMPL
 
 		float zVal;
 
+		// still the engine's projection, Projection::ProjectPoint differs from it for points behind the camera
 		RE::NiCamera::WorldPtToScreenPt3((float(*)[4])(REL::ID(519579).address()),
 			*((RE::NiRect<float>*)REL::ID(519618).address()), niWorldLoc, screenLocOut.x, screenLocOut.y, zVal, 1e-5f);
 		RE::GRectF rect = movie->GetVisibleFrameRect();
@@ -663,6 +1121,7 @@ namespace DebugAPI_IMPL
 		inputContext = Context::kNone;
 		depthPriority = 127;
 
+		menuFlags.set(RE::UI_MENU_FLAGS::kAlwaysOpen);
 		menuFlags.set(RE::UI_MENU_FLAGS::kRequiresUpdate);
 		menuFlags.set(RE::UI_MENU_FLAGS::kAllowSaving);
 		menuFlags.set(RE::UI_MENU_FLAGS::kCustomRendering);
@@ -672,25 +1131,155 @@ namespace DebugAPI_IMPL
 		});
 	}
 
-	void DebugOverlayMenu::Register()
+	spdlog::logger& DebugOverlayMenu::Logger::GetLog()
 	{
-		auto ui = RE::UI::GetSingleton();
-		if (ui) {
-			ui->Register(MENU_NAME, Creator);
+		static const auto log = [] {
+			spdlog::init_thread_pool(ASYNC_QUEUE_SIZE, 1);
+
+			const auto& sinks = spdlog::default_logger()->sinks();
+			auto asyncLog = std::make_shared<spdlog::async_logger>(std::string(LOG_NAME), sinks.begin(), sinks.end(),
+				spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+			spdlog::initialize_logger(asyncLog);
+			asyncLog->set_level(spdlog::default_logger()->level());
+			// flushing happens on the log thread as well
+			asyncLog->flush_on(spdlog::level::info);
+			return asyncLog;
+		}();
+
+		return *log;
+	}
 
-			DebugOverlayMenu::Show();
-		}
+	DebugOverlayMenu::Logger::Registry& DebugOverlayMenu::Logger::GetRegistry()
+	{
+		// constructed after the log, so its destructor can still log into it
+		GetLog();
+		static Registry registry;
+		return registry;
 	}
 
-	void DebugOverlayMenu::Show()
+	DebugOverlayMenu::Logger::Registry::~Registry()
 	{
-		auto msgQ = RE::UIMessageQueue::GetSingleton();
-		if (msgQ) {
-			msgQ->AddMessage(DebugOverlayMenu::MENU_NAME, RE::UI_MESSAGE_TYPE::kShow, nullptr);
+		std::lock_guard<std::mutex> lock(Mutex);
+		for (auto state : States) {
+			LogPending(*state);
 		}
 	}
 
-	void DebugOverlayMenu::Hide()
+	DebugOverlayMenu::Logger::ThreadState::ThreadState()
+	{
+		auto& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+		registry.States.push_back(this);
+	}
+
+	DebugOverlayMenu::Logger::ThreadState::~ThreadState()
+	{
+		auto& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+		LogPending(*this);
+		std::erase(registry.States, this);
+	}
+
+	void DebugOverlayMenu::Logger::LogPending(ThreadState& state)
+	{
+		if (const auto repeats = state.Repeats.exchange(0, std::memory_order_relaxed)) {
+			GetLog().info(FMT_STRING("last message repeated {} times"), repeats);
+		}
+		if (const auto dropped = state.Dropped.exchange(0, std::memory_order_relaxed)) {
+			GetLog().warn(FMT_STRING("{} messages dropped"), dropped);
+		}
+	}
+
+	void DebugOverlayMenu::Logger::FlushPending()
+	{
+		auto& registry = GetRegistry();
+
+		const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+		auto next = registry.NextFlush.load(std::memory_order_relaxed);
+		if (now < next)
+			return;
+
+		// claimed with a compare exchange, so concurrent callers flush once
+		const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(FLUSH_INTERVAL).count();
+		if (!registry.NextFlush.compare_exchange_strong(next, now + interval, std::memory_order_relaxed))
+			return;
+
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+		for (auto state : registry.States) {
+			LogPending(*state);
+		}
+	}
+
+	void DebugOverlayMenu::Logger::LogMessageVarg(LogMessageType, const char* a_fmt, std::va_list a_argList)
+	{
+		auto& log = GetLog();
+		thread_local ThreadState state;
+
+		const int written = std::vsnprintf(state.Buffer, MAX_MESSAGE_LENGTH, a_fmt ? a_fmt : "", a_argList);
+		if (written < 0)
+			return;
+
+		auto length = std::min(static_cast<std::size_t>(written), MAX_MESSAGE_LENGTH - 1);
+		while (length && state.Buffer[length - 1] == '\n') {
+			length--;
+		}
+		const std::string_view message(state.Buffer, length);
+
+		if (message == std::string_view(state.Last, state.LastLength)) {
+			state.Repeats.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		if (const auto repeats = state.Repeats.exchange(0, std::memory_order_relaxed)) {
+			log.info(FMT_STRING("last message repeated {} times"), repeats);
+		}
+		std::memcpy(state.Last, state.Buffer, length);
+		state.LastLength = length;
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now - state.SecondStart >= std::chrono::seconds(1)) {
+			if (const auto dropped = state.Dropped.exchange(0, std::memory_order_relaxed)) {
+				log.warn(FMT_STRING("{} messages dropped"), dropped);
+			}
+			state.SecondStart = now;
+			state.SecondCount = 0;
+		}
+
+		if (state.SecondCount == MAX_MESSAGES_PER_SECOND) {
+			state.Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		state.SecondCount++;
+
+		log.info("{}"sv, message);
+	}
+
+	void DebugOverlayMenu::Register()
+	{
+		// a menu without its movie would be opened all the same, the HUD is the better place to draw then
+		const auto path = "Data/Interface/"s + MENU_PATH + ".swf"s;
+		if (!std::filesystem::exists(path)) {
+			logger::info(FMT_STRING("{} not found, drawing into the HUD"), path);
+			return;
+		}
+
+		auto ui = RE::UI::GetSingleton();
+		if (ui) {
+			ui->Register(MENU_NAME, Creator);
+
+			DebugOverlayMenu::Show();
+		}
+	}
+
+	void DebugOverlayMenu::Show()
+	{
+		auto msgQ = RE::UIMessageQueue::GetSingleton();
+		if (msgQ) {
+			msgQ->AddMessage(DebugOverlayMenu::MENU_NAME, RE::UI_MESSAGE_TYPE::kShow, nullptr);
+		}
+	}
+
+	void DebugOverlayMenu::Hide()
 	{
 		auto msgQ = RE::UIMessageQueue::GetSingleton();
 		if (msgQ) {
@@ -703,7 +1292,7 @@ namespace DebugAPI_IMPL
 		if (CachedMenuData)
 			return;
 
-		RE::GPtr<RE::IMenu> menu = RE::UI::GetSingleton()->GetMenu(DebugOverlayMenu::MENU_NAME);
+		RE::GPtr<RE::IMenu> menu = GetHUD();
 		if (!menu || !menu->uiMovie)
 			return;
 
@@ -724,62 +1313,965 @@ namespace DebugAPI_IMPL
 
 	void DebugOverlayMenu::AdvanceMovie(float a_interval, std::uint32_t a_currentTime)
 	{
+		// the overlay is drawn by DebugAPIHook, once per frame
 		RE::IMenu::AdvanceMovie(a_interval, a_currentTime);
-
-		DebugAPI::Update();
 	}
 }
 
-static const inline RE::BSFixedString path = "marker_light.nif";
+// replaces the models of the forms picked by the [Patch:*] sections of the INI, e.g. to make invisible markers visible:
+//   [Patch:Lights]
+//   sFormTypes = LIGH           ; form type signatures, comma separated. Only forms that have a model can be patched
+//   bEmptyModel = true          ; matches forms without a model
+//   sModelContains =            ; and/or forms whose model path contains this, case insensitive
+//   sModel = marker_light.nif   ; the model matching forms get
+// The first matching section wins. Without any, lights without a model get marker_light.nif
+class FormPatcher
+{
+public:
+	void LoadRules();
+
+	// matches every form of the rules' form types in parallel, then applies the matches on the calling thread. The
+	// matches are cached next to the log, keyed on the rules and the load order, and simply applied again as long as
+	// neither changed
+	void Run();
+
+private:
+	struct Rule
+	{
+		std::string Name;
+		std::vector<RE::FormType> FormTypes;
+		bool EmptyModel = false;
+		// lower case
+		std::string ModelContains;
+		RE::BSFixedString Model;
+	};
+
+	struct Match
+	{
+		RE::FormID FormID;
+		RE::TESModel* Model;
+		std::uint32_t Rule;
+	};
+
+	// forms matched per task
+	static constexpr std::uint32_t CHUNK_FORMS = 4096;
+
+	// magic, version, key, rule count, match count, { form id, rule } * match count
+	static constexpr std::uint32_t CACHE_MAGIC = 0x48435046;  // "FPCH"
+	static constexpr std::uint32_t CACHE_VERSION = 1;
+
+	static bool Matches(const Rule& rule, const RE::TESModel& model);
+	std::vector<Match> Scan() const;
+
+	// FNV-1a over the rules and the name, size and write time of every loaded plugin, in load order
+	std::uint64_t GetCacheKey() const;
+	// std::nullopt without a log directory, nothing is cached then
+	static std::optional<std::filesystem::path> GetCachePath();
+	// false unless the cache exists, matches key and every cached form still resolves. Nothing is applied then
+	bool ReadCache(std::uint64_t key, std::vector<Match>& matches) const;
+	void WriteCache(std::uint64_t key, const std::vector<Match>& matches) const;
+
+	std::vector<Rule> Rules;
+};
+
+void FormPatcher::LoadRules()
+{
+	Rules.clear();
+
+	CSimpleIniA ini;
+	ini.SetUnicode();
+	ini.LoadFile(DebugAPI_IMPL::Settings::GetPath().c_str());
+
+	CSimpleIniA::TNamesDepend sections;
+	ini.GetAllSections(sections);
+	sections.sort(CSimpleIniA::Entry::LoadOrder());
+
+	for (const auto& section : sections) {
+		const std::string_view name = section.pItem;
+		if (!name.starts_with("Patch:"sv))
+			continue;
+
+		Rule rule;
+		rule.Name = name;
+		rule.EmptyModel = ini.GetBoolValue(section.pItem, "bEmptyModel", false);
+		rule.ModelContains = ini.GetValue(section.pItem, "sModelContains", "");
+		std::ranges::transform(rule.ModelContains, rule.ModelContains.begin(),
+			[](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+		rule.Model = ini.GetValue(section.pItem, "sModel", "");
+
+		std::string formTypes = ini.GetValue(section.pItem, "sFormTypes", "");
+		for (const auto token : std::views::split(formTypes, ',')) {
+			std::string_view signature(token.begin(), token.end());
+			signature.remove_prefix(std::min(signature.find_first_not_of(' '), signature.size()));
+			signature.remove_suffix(signature.size() - std::min(signature.find_last_not_of(' ') + 1, signature.size()));
+			if (signature.empty())
+				continue;
+
+			const auto formType = RE::StringToFormType(signature);
+			if (formType == RE::FormType::None) {
+				logger::warn(FMT_STRING("{}: unknown form type {}"), rule.Name, signature);
+				continue;
+			}
+			rule.FormTypes.push_back(formType);
+		}
+
+		if (rule.FormTypes.empty() || rule.Model.empty() || (!rule.EmptyModel && rule.ModelContains.empty())) {
+			logger::warn(FMT_STRING("{}: needs sFormTypes, sModel and bEmptyModel or sModelContains, skipped"), rule.Name);
+			continue;
+		}
+
+		Rules.push_back(std::move(rule));
+	}
+
+	if (Rules.empty()) {
+		Rule rule;
+		rule.Name = "default";
+		rule.FormTypes.push_back(RE::FormType::Light);
+		rule.EmptyModel = true;
+		rule.Model = "marker_light.nif";
+		Rules.push_back(std::move(rule));
+	}
+}
 
-void change_model(RE::TESObjectLIGH* ligh)
+bool FormPatcher::Matches(const Rule& rule, const RE::TESModel& model)
 {
-	ligh->model = path;
+	const char* data = model.model.data();
+	const std::string_view path = data ? std::string_view(data, model.model.length()) : std::string_view();
+
+	if (rule.EmptyModel && path.empty())
+		return true;
+
+	if (rule.ModelContains.empty())
+		return false;
+
+	const auto found = std::search(path.begin(), path.end(), rule.ModelContains.begin(), rule.ModelContains.end(),
+		[](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+	return found != path.end();
 }
 
-void change_models() {
-	auto& a = RE::TESDataHandler::GetSingleton()->formArrays[static_cast<int>(RE::FormType::Light)];
-	
-	for (auto& _i : a) { auto i = _i->As<RE::TESObjectLIGH>();
-		if (!i || i->FORMTYPE != RE::FormType::Light)
+std::vector<FormPatcher::Match> FormPatcher::Scan() const
+{
+	auto dataHandler = RE::TESDataHandler::GetSingleton();
+
+	// indices into Rules per form type, in INI order
+	std::array<std::vector<std::uint32_t>, static_cast<std::size_t>(RE::FormType::Max)> typeRules;
+	for (std::uint32_t i = 0; i < Rules.size(); i++) {
+		for (auto formType : Rules[i].FormTypes) {
+			auto& rules = typeRules[static_cast<std::size_t>(formType)];
+			if (std::ranges::find(rules, i) == rules.end()) {
+				rules.push_back(i);
+			}
+		}
+	}
+
+	struct Chunk
+	{
+		std::size_t FormType;
+		std::uint32_t Begin;
+		std::uint32_t End;
+		std::vector<Match> Matches;
+	};
+
+	std::vector<Chunk> chunks;
+	for (std::size_t formType = 0; formType < typeRules.size(); formType++) {
+		if (typeRules[formType].empty())
 			continue;
 
-		if (!i->model.data() || !i->model.length()) {
-			change_model(i);
+		const auto size = dataHandler->formArrays[formType].size();
+		for (std::uint32_t begin = 0; begin < size; begin += CHUNK_FORMS) {
+			chunks.push_back({ formType, begin, std::min(begin + CHUNK_FORMS, size) });
+		}
+	}
+
+	// only reads the forms, nothing is written until every chunk is done
+	std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](Chunk& chunk) {
+		const auto& forms = dataHandler->formArrays[chunk.FormType];
+		const auto& rules = typeRules[chunk.FormType];
+		for (auto i = chunk.Begin; i < chunk.End; i++) {
+			auto model = forms[i] ? forms[i]->As<RE::TESModel>() : nullptr;
+			if (!model)
+				continue;
+
+			for (auto rule : rules) {
+				if (Matches(Rules[rule], *model)) {
+					chunk.Matches.push_back({ forms[i]->GetFormID(), model, rule });
+					break;
+				}
+			}
+		}
+	});
+
+	std::vector<Match> matches;
+	for (auto& chunk : chunks) {
+		matches.insert(matches.end(), chunk.Matches.begin(), chunk.Matches.end());
+	}
+	return matches;
+}
+
+std::uint64_t FormPatcher::GetCacheKey() const
+{
+	std::uint64_t key = 0xcbf29ce484222325;
+	auto hash = [&key](const void* data, std::size_t size) {
+		for (std::size_t i = 0; i < size; i++) {
+			key = (key ^ static_cast<const std::uint8_t*>(data)[i]) * 0x100000001b3;
 		}
+	};
+	auto hashString = [&hash](std::string_view string) {
+		hash(string.data(), string.size());
+		hash("", 1);
+	};
+
+	hash(&CACHE_VERSION, sizeof(CACHE_VERSION));
+
+	for (const auto& rule : Rules) {
+		hashString(rule.Name);
+		hash(rule.FormTypes.data(), rule.FormTypes.size() * sizeof(RE::FormType));
+		hash(&rule.EmptyModel, sizeof(rule.EmptyModel));
+		hashString(rule.ModelContains);
+		hashString(rule.Model.c_str());
+	}
+
+	auto hashFile = [&](const RE::TESFile* file) {
+		hashString(file->fileName);
+
+		std::error_code error;
+		const auto path = std::filesystem::path("Data") / file->fileName;
+		const auto size = std::filesystem::file_size(path, error);
+		const auto writeTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+		hash(&size, sizeof(size));
+		hash(&writeTime, sizeof(writeTime));
+	};
+
+	// VR has no light plugins, its load order is a plain array
+	auto dataHandler = RE::TESDataHandler::GetSingleton();
+#ifdef SKYRIMVR
+	for (std::uint32_t i = 0; i < dataHandler->loadedModCount; i++) {
+		hashFile(dataHandler->loadedMods[i]);
+	}
+#else
+	for (auto file : dataHandler->compiledFileCollection.files) {
+		hashFile(file);
 	}
+	for (auto file : dataHandler->compiledFileCollection.smallFiles) {
+		hashFile(file);
+	}
+#endif
+
+	return key;
+}
+
+std::optional<std::filesystem::path> FormPatcher::GetCachePath()
+{
+	auto path = logger::log_directory();
+	if (!path)
+		return std::nullopt;
+
+	*path /= Version::PROJECT;
+	*path += ".patchcache"sv;
+	return path;
 }
 
-void draw_navmeshes()
+bool FormPatcher::ReadCache(std::uint64_t key, std::vector<Match>& matches) const
 {
-	if (auto _navmeshes = RE::PlayerCharacter::GetSingleton()->GetParentCell()->navMeshes) {
-		const auto& navmeshes = _navmeshes->navMeshes;
-		for (auto& _navmesh : navmeshes) {
+	const auto path = GetCachePath();
+	if (!path)
+		return false;
+
+	std::ifstream file(*path, std::ios::binary);
+
+	std::uint32_t header[2] = {};
+	std::uint64_t cachedKey = 0;
+	std::uint32_t counts[2] = {};
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+	file.read(reinterpret_cast<char*>(&cachedKey), sizeof(cachedKey));
+	file.read(reinterpret_cast<char*>(counts), sizeof(counts));
+	if (!file || header[0] != CACHE_MAGIC || header[1] != CACHE_VERSION || cachedKey != key || counts[0] != Rules.size())
+		return false;
+
+	std::vector<std::array<std::uint32_t, 2>> entries(counts[1]);
+	if (!file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(entries[0])))
+		return false;
+
+	matches.clear();
+	matches.reserve(entries.size());
+	for (const auto& [formID, rule] : entries) {
+		auto form = RE::TESForm::LookupByID(formID);
+		auto model = form ? form->As<RE::TESModel>() : nullptr;
+		if (!model || rule >= Rules.size())
+			return false;
+
+		matches.push_back({ formID, model, rule });
+	}
+
+	return true;
+}
+
+void FormPatcher::WriteCache(std::uint64_t key, const std::vector<Match>& matches) const
+{
+	const auto path = GetCachePath();
+	if (!path)
+		return;
+
+	std::ofstream file(*path, std::ios::binary | std::ios::trunc);
+
+	const std::uint32_t header[2] = { CACHE_MAGIC, CACHE_VERSION };
+	const std::uint32_t counts[2] = { static_cast<std::uint32_t>(Rules.size()), static_cast<std::uint32_t>(matches.size()) };
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+	file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+
+	for (const auto& match : matches) {
+		const std::uint32_t entry[2] = { match.FormID, match.Rule };
+		file.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+	}
+
+	if (!file) {
+		logger::warn(FMT_STRING("couldn't write {}"), path->string());
+	}
+}
+
+void FormPatcher::Run()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	const auto key = GetCacheKey();
+
+	std::vector<Match> matches;
+	const bool cached = ReadCache(key, matches);
+	if (!cached) {
+		matches = Scan();
+	}
+
+	const auto matched = std::chrono::steady_clock::now();
+
+	std::vector<std::uint32_t> patched(Rules.size());
+	for (const auto& match : matches) {
+		match.Model->model = Rules[match.Rule].Model;
+		patched[match.Rule]++;
+	}
+
+	if (!cached) {
+		WriteCache(key, matches);
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	for (std::uint32_t i = 0; i < Rules.size(); i++) {
+		logger::info(FMT_STRING("{}: {} forms now use {}"), Rules[i].Name, patched[i], Rules[i].Model.c_str());
+	}
+	logger::info(FMT_STRING("patched forms: {} in {:.2f}ms, applied in {:.2f}ms"), cached ? "read from the cache" : "scanned",
+		std::chrono::duration<double, std::milli>(matched - start).count(),
+		std::chrono::duration<double, std::milli>(end - matched).count());
+}
+
+// keeps a NavmeshGrid in sync with the navmeshes of every loaded cell. Sync only diffs the loaded cells against the
+// indexed navmeshes, geometry is only extracted for navmeshes that were just attached or whose arrays changed
+class NavmeshStreamer
+{
+public:
+	void Sync()
+	{
+		Seen.clear();
+		Attached.clear();
+		Detached.clear();
+		Changed = false;
+
+		auto tes = RE::TES::GetSingleton();
+		if (!tes)
+			return;
+
+		if (auto grid = tes->gridCells) {
+			for (std::uint32_t i = 0; i < grid->length * grid->length; i++) {
+				SyncCell(grid->cells[i]);
+			}
+		}
+		SyncCell(tes->interiorCell);
+
+		for (auto it = Fingerprints.begin(); it != Fingerprints.end();) {
+			if (!Seen.contains(it->first)) {
+				Grid.RemoveMesh(it->first);
+				Detached.push_back(it->first);
+				Changed = true;
+				it = Fingerprints.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	// the navmesh's vertices and triangles as they are, nothing is validated
+	static void ReadArrays(RE::BSNavmesh* navmesh, std::vector<glm::vec3>& points,
+		std::vector<std::array<std::uint32_t, 3>>& triangles)
+	{
+		points.clear();
+		points.reserve(navmesh->vertices.size());
+		for (auto& vertex : navmesh->vertices) {
+			points.emplace_back(vertex.location.x, vertex.location.y, vertex.location.z);
+		}
+
+		triangles.clear();
+		triangles.reserve(navmesh->triangles.size());
+		for (auto& triangle : navmesh->triangles) {
+			triangles.push_back({ triangle.vertices[0], triangle.vertices[1], triangle.vertices[2] });
+		}
+	}
+
+	DebugAPI_IMPL::NavmeshGrid Grid;
+
+	struct RawMesh
+	{
+		std::uint32_t Key;
+		std::vector<glm::vec3> Points;
+		std::vector<std::array<std::uint32_t, 3>> Triangles;
+	};
+
+	// with KeepRawMeshes, the arrays of the navmeshes the last Sync added or updated (see ReadArrays). Detached are the
+	// keys of the ones it removed
+	bool KeepRawMeshes = false;
+	std::vector<RawMesh> Attached;
+	std::vector<std::uint32_t> Detached;
+	// whether the last Sync added, updated or removed anything
+	bool Changed = false;
+
+private:
+	// the navmesh and its arrays' addresses and sizes. Comparing them costs the same however large the navmesh is, so
+	// an idle Sync never reads the geometry. An edit that keeps every array where it was and as large as it was goes
+	// unnoticed until the cell is reloaded
+	struct Fingerprint
+	{
+		const void* Navmesh;
+		const void* Vertices;
+		std::uint32_t VertexCount;
+		const void* Triangles;
+		std::uint32_t TriangleCount;
+
+		bool operator==(const Fingerprint&) const = default;
+	};
+
+	void SyncCell(RE::TESObjectCELL* cell)
+	{
+		if (!cell || !cell->navMeshes)
+			return;
+
+		for (auto& _navmesh : cell->navMeshes->navMeshes) {
 			auto navmesh = _navmesh.get();
-			auto& vertices = navmesh->vertices;
+			if (!navmesh)
+				continue;
+
+			const auto key = navmesh->GetFormID();
+			const Fingerprint fingerprint{ navmesh, navmesh->vertices.data(), navmesh->vertices.size(),
+				navmesh->triangles.data(), navmesh->triangles.size() };
+
+			Seen.insert(key);
+
+			auto it = Fingerprints.find(key);
+			if (it != Fingerprints.end() && it->second == fingerprint)
+				continue;
+
+			Fingerprints[key] = fingerprint;
+			Changed = true;
+
+			std::vector<glm::vec3> points;
+			std::vector<std::array<std::uint32_t, 3>> triangles;
+			ReadArrays(navmesh, points, triangles);
+			if (KeepRawMeshes) {
+				Attached.push_back({ key, points, triangles });
+			}
+
+			DebugAPI_IMPL::NavmeshGeometry geometry;
+			geometry.Build(std::move(points), triangles);
+			Grid.AddMesh(key, std::move(geometry));
+		}
+	}
+
+	std::unordered_map<std::uint32_t, Fingerprint> Fingerprints;
+	std::unordered_set<std::uint32_t> Seen;
+};
+
+// collects the navmeshes of every cell loaded while the player is in a world (worldspace or interior) and writes them
+// to <log dir>/CreationKitInSkyrim.<world FormID>.navmesh, see DebugAPI_IMPL::NavmeshExport. The file is rewritten when
+// the player leaves the world, and at most every EXPORT_INTERVAL_MS while new navmeshes come in. Each world keeps what
+// was collected for it during the session, so coming back to a world adds to its export. A navmesh is exported as it
+// was when its cell was first seen.
+// The game thread only copies the arrays of navmeshes it hasn't seen yet, Flush hands them to a worker thread which owns
+// a Writer per world, so laying out and writing the whole world never holds up a frame
+class NavmeshExporter
+{
+public:
+	static constexpr std::uint64_t EXPORT_INTERVAL_MS = 10000;
+
+	static NavmeshExporter& GetSingleton();
+
+	void Sync()
+	{
+		auto tes = RE::TES::GetSingleton();
+		if (!tes)
+			return;
+
+		RE::TESForm* world = tes->interiorCell ? static_cast<RE::TESForm*>(tes->interiorCell) : tes->worldSpace;
+		const auto worldFormID = world ? world->GetFormID() : 0;
+		if (worldFormID != World) {
+			Flush();
+			World = worldFormID;
+			WorldName = world ? world->GetFormEditorID() : "";
+		}
+
+		if (!world)
+			return;
 
-			for (auto& vertex : vertices) {
-				draw_point<Colors::BLU>(vertex.location, 5, 0);
+		if (auto grid = tes->gridCells) {
+			for (std::uint32_t i = 0; i < grid->length * grid->length; i++) {
+				AddCell(grid->cells[i]);
 			}
+		}
+		AddCell(tes->interiorCell);
+
+		const auto now = GetTickCount64();
+		if (!Incoming.empty() && now >= NextWrite) {
+			Flush();
+			NextWrite = now + EXPORT_INTERVAL_MS;
+		}
+	}
+
+private:
+	struct ExportMesh
+	{
+		std::uint32_t FormID;
+		std::uint32_t CellFormID;
+		std::int32_t CellX;
+		std::int32_t CellY;
+		std::vector<glm::vec3> Points;
+		std::vector<std::array<std::uint32_t, 3>> Triangles;
+	};
+
+	// the navmeshes found since the last Flush, all of one world
+	struct Job
+	{
+		RE::FormID World;
+		std::string WorldName;
+		std::vector<ExportMesh> Meshes;
+	};
+
+	NavmeshExporter() { std::thread(&NavmeshExporter::Run, this).detach(); }
+
+	void AddCell(RE::TESObjectCELL* cell)
+	{
+		if (!cell || !cell->navMeshes)
+			return;
+
+		auto x = DebugAPI_IMPL::NavmeshExport::INTERIOR;
+		auto y = DebugAPI_IMPL::NavmeshExport::INTERIOR;
+		if (cell->IsExteriorCell() && cell->cellData.exterior) {
+			x = cell->cellData.exterior->cellX;
+			y = cell->cellData.exterior->cellY;
+		}
+
+		auto& exported = Exported[World];
+		for (auto& _navmesh : cell->navMeshes->navMeshes) {
+			auto navmesh = _navmesh.get();
+			if (!navmesh || !exported.insert(navmesh->GetFormID()).second)
+				continue;
+
+			auto& mesh = Incoming.emplace_back(ExportMesh{ navmesh->GetFormID(), cell->GetFormID(), x, y });
+			NavmeshStreamer::ReadArrays(navmesh, mesh.Points, mesh.Triangles);
+		}
+	}
+
+	// never waits for the worker, jobs queue up while it is still writing
+	void Flush()
+	{
+		if (Incoming.empty())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Jobs.push_back({ World, WorldName, std::move(Incoming) });
+		}
+		JobReady.notify_one();
+		Incoming.clear();
+	}
+
+	void Run();
+
+	// game thread
+	RE::FormID World = 0;
+	std::string WorldName;
+	std::uint64_t NextWrite = 0;
+	// navmesh FormIDs by world
+	std::unordered_map<RE::FormID, std::unordered_set<std::uint32_t>> Exported;
+	std::vector<ExportMesh> Incoming;
+
+	std::mutex Mutex;
+	std::condition_variable JobReady;
+	std::vector<Job> Jobs;
+
+	// worker thread, by world
+	std::unordered_map<RE::FormID, DebugAPI_IMPL::NavmeshExport::Writer> Writers;
+};
+
+NavmeshExporter& NavmeshExporter::GetSingleton()
+{
+	// never destroyed, the detached worker thread keeps using it until the process is gone
+	static auto exporter = new NavmeshExporter();
+	return *exporter;
+}
+
+void NavmeshExporter::Run()
+{
+	std::vector<Job> jobs;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(Mutex);
+			JobReady.wait(lock, [this] { return !Jobs.empty(); });
+			jobs.swap(Jobs);
+		}
+
+		for (auto& job : jobs) {
+			auto& writer = Writers[job.World];
+			for (const auto& mesh : job.Meshes) {
+				writer.AddMesh(mesh.FormID, mesh.CellFormID, mesh.CellX, mesh.CellY, mesh.Points, mesh.Triangles);
+			}
+
+			auto path = logger::log_directory();
+			if (!path)
+				continue;
+
+			*path /= fmt::format(FMT_STRING("{}.{:08X}.navmesh"), Version::PROJECT, job.World);
+			if (!writer.Write(*path, job.World, job.WorldName)) {
+				logger::error(FMT_STRING("couldn't write {}"), path->string());
+				continue;
+			}
+
+			logger::info(FMT_STRING("exported {} navmeshes of {} to {}"), writer.GetMeshCount(), job.WorldName,
+				path->string());
+		}
+		jobs.clear();
+	}
+}
+
+// only triangles this close to the camera are drawn
+static constexpr float NAVMESH_DRAW_RADIUS = 4096.0f;
+
+// builds the navmesh wireframe on a worker thread, one frame ahead of the render stage. The game thread only touches
+// the grid and the line buffer while the worker is idle: Kick waits for the previous job, hands its lines to the
+// renderer, syncs the grid with the loaded cells and starts the next job, which then runs alongside the rest of the frame.
+// Navmeshes the sync added are checked in the same job, their findings are drawn on top of the wireframe until the
+// navmesh goes away. With actor paths on, Kick also takes the positions of the actors near the player, and the job
+// finds their paths to the player
+class NavmeshOverlayWorker
+{
+public:
+	static NavmeshOverlayWorker& GetSingleton();
+
+	void Kick(const glm::vec3& center);
+
+private:
+	NavmeshOverlayWorker();
+
+	static constexpr std::size_t MAX_PATH_ACTORS = 32;
+
+	void Run();
+	void Analyze();
+	void RemoveHighlight(std::uint32_t key);
+	void CollectPathQueries(const glm::vec3& center);
+	void FindPaths();
+
+	static void AddHighlight(const NavmeshStreamer::RawMesh& mesh, const DebugAPI_IMPL::NavmeshAnalyzer::Finding& finding,
+		std::vector<DebugAPI_IMPL::LineRenderer::BatchLine>& lines);
+
+	NavmeshStreamer Streamer;
+
+	std::mutex Mutex;
+	std::condition_variable JobReady;
+	std::condition_variable JobDone;
+	bool Busy = false;
+	glm::vec3 Center;
+
+	std::vector<DebugAPI_IMPL::LineCommand> Lines;
+	// retained batches by navmesh key, a navmesh's findings don't change until it is loaded again
+	std::unordered_map<std::uint32_t, DebugAPI_IMPL::LineRenderer::BatchHandle> Highlights;
+
+	// rebuilt when the streamer's navmeshes change
+	DebugAPI_IMPL::NavmeshGraph Graph;
+	bool GraphDirty = true;
+	DebugAPI_IMPL::NavmeshPathfinderPool Pathfinders;
+	std::vector<DebugAPI_IMPL::NavmeshPathfinderPool::Query> PathQueries;
+	std::vector<std::vector<glm::vec3>> Paths;
+};
+
+NavmeshOverlayWorker& NavmeshOverlayWorker::GetSingleton()
+{
+	// never destroyed, the detached worker thread keeps using it until the process is gone
+	static auto worker = new NavmeshOverlayWorker();
+	return *worker;
+}
+
+NavmeshOverlayWorker::NavmeshOverlayWorker()
+{
+	Streamer.KeepRawMeshes = DebugAPI_IMPL::Settings::NavmeshAnalyze;
+	std::thread(&NavmeshOverlayWorker::Run, this).detach();
+}
+
+void NavmeshOverlayWorker::Kick(const glm::vec3& center)
+{
+	auto& renderer = DebugAPI_IMPL::DebugAPI::Renderer;
+	DebugAPI_IMPL::ScopedPerfTimer timer(renderer.GetCounters(), DebugAPI_IMPL::PerfCounters::kNavmeshSync);
 
-			for (auto& triangle : navmesh->triangles) {
-				auto point0 = vertices[triangle.vertices[0]].location;
-				auto point1 = vertices[triangle.vertices[1]].location;
-				auto point2 = vertices[triangle.vertices[2]].location;
-				draw_line(point0, point1, 3, 0);
-				draw_line(point0, point2, 3, 0);
-				draw_line(point2, point1, 3, 0);
-				auto mid = point0 + point1 + point2;
-				mid *= 1.0f / 3.0f;
-
-				draw_line<Colors::GRN>(point0, mid, 3, 0);
-				draw_line<Colors::GRN>(point1, mid, 3, 0);
-				draw_line<Colors::GRN>(point2, mid, 3, 0);
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		JobDone.wait(lock, [this] { return !Busy; });
+	}
+
+	if (!Lines.empty()) {
+		renderer.Submit(Lines);
+	}
+
+	Streamer.Sync();
+	GraphDirty |= Streamer.Changed;
+
+	PathQueries.clear();
+	if (DebugAPI_IMPL::Settings::NavmeshActorPaths) {
+		CollectPathQueries(center);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Center = center;
+		Busy = true;
+	}
+	JobReady.notify_one();
+}
+
+void NavmeshOverlayWorker::Run()
+{
+	struct WireframeVisitor
+	{
+		void Triangle(const DebugAPI_IMPL::NavmeshGeometry& geometry, std::uint32_t triangle)
+		{
+			for (auto vertex : geometry.Triangles[triangle]) {
+				Add(geometry.Points[vertex], geometry.Centroids[triangle], TRIANGLE_COLOR, 3.0f);
 			}
 		}
+
+		void Edge(const DebugAPI_IMPL::NavmeshGeometry& geometry, std::uint32_t edge)
+		{
+			const auto [from, to] = geometry.Edges[edge];
+			Add(geometry.Points[from], geometry.Points[to], EDGE_COLOR, 3.0f);
+		}
+
+		void Point(const DebugAPI_IMPL::NavmeshGeometry& geometry, std::uint32_t point)
+		{
+			const auto& pos = geometry.Points[point];
+			Add(pos, pos + glm::vec3(0.0f, 0.0f, 5.0f), POINT_COLOR, 5.0f);
+		}
+
+		void Add(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float thickness)
+		{
+			Lines.push_back({ from, to, color, thickness, DebugAPI_IMPL::LineCommand::TRANSIENT });
+		}
+
+		const std::uint32_t TRIANGLE_COLOR = DebugAPI_IMPL::DebugAPILine::PackColor(Colors::GRN);
+		const std::uint32_t EDGE_COLOR = DebugAPI_IMPL::DebugAPILine::PackColor(Colors::RED);
+		const std::uint32_t POINT_COLOR = DebugAPI_IMPL::DebugAPILine::PackColor(Colors::BLU);
+
+		std::vector<DebugAPI_IMPL::LineCommand>& Lines;
+	};
+
+	while (true) {
+		std::unique_lock<std::mutex> lock(Mutex);
+		JobReady.wait(lock, [this] { return Busy; });
+		const auto center = Center;
+		lock.unlock();
+
+		{
+			DebugAPI_IMPL::ScopedPerfTimer timer(DebugAPI_IMPL::DebugAPI::Renderer.GetCounters(),
+				DebugAPI_IMPL::PerfCounters::kNavmeshBuild);
+
+			Lines.clear();
+			WireframeVisitor visitor{ .Lines = Lines };
+			Streamer.Grid.QueryRadius(center, NAVMESH_DRAW_RADIUS, visitor);
+
+			Analyze();
+		}
+
+		if (!PathQueries.empty()) {
+			DebugAPI_IMPL::ScopedPerfTimer timer(DebugAPI_IMPL::DebugAPI::Renderer.GetCounters(),
+				DebugAPI_IMPL::PerfCounters::kNavmeshPaths);
+			FindPaths();
+		}
+
+		lock.lock();
+		Busy = false;
+		lock.unlock();
+		JobDone.notify_one();
+	}
+}
+
+void NavmeshOverlayWorker::CollectPathQueries(const glm::vec3& center)
+{
+	auto player = RE::PlayerCharacter::GetSingleton();
+	auto processLists = RE::ProcessLists::GetSingleton();
+	if (!player || !processLists)
+		return;
+
+	const auto playerPosition = player->GetPosition();
+	const glm::vec3 to(playerPosition.x, playerPosition.y, playerPosition.z);
+
+	for (auto& handle : processLists->highActorHandles) {
+		auto actor = handle.get();
+		if (!actor || actor->IsDead())
+			continue;
+
+		const auto position = actor->GetPosition();
+		const glm::vec3 from(position.x, position.y, position.z);
+		if (glm::distance(from, center) > NAVMESH_DRAW_RADIUS)
+			continue;
+
+		PathQueries.push_back({ from, to });
+		if (PathQueries.size() == MAX_PATH_ACTORS)
+			break;
 	}
 }
 
+void NavmeshOverlayWorker::FindPaths()
+{
+	if (GraphDirty) {
+		std::vector<const DebugAPI_IMPL::NavmeshGeometry*> meshes;
+		meshes.reserve(Streamer.Grid.GetMeshCount());
+		Streamer.Grid.ForEachMesh(
+			[&](std::uint32_t, const DebugAPI_IMPL::NavmeshGeometry& geometry) { meshes.push_back(&geometry); });
+
+		Graph.Build(meshes);
+		GraphDirty = false;
+	}
+
+	Pathfinders.Run(Graph, PathQueries, Paths);
+
+	// lifted above the wireframe and the analyzer's highlights
+	static constexpr glm::vec3 LIFT(0.0f, 0.0f, 16.0f);
+	static const auto PATH_COLOR = DebugAPI_IMPL::DebugAPILine::PackColor({ 1.0f, 0.85f, 0.0f, 1.0f });
+
+	for (const auto& path : Paths) {
+		for (std::size_t i = 1; i < path.size(); i++) {
+			Lines.push_back({ path[i - 1] + LIFT, path[i] + LIFT, PATH_COLOR, 3.0f, DebugAPI_IMPL::LineCommand::TRANSIENT });
+		}
+	}
+}
+
+void NavmeshOverlayWorker::Analyze()
+{
+	namespace Analyzer = DebugAPI_IMPL::NavmeshAnalyzer;
+
+	for (auto key : Streamer.Detached) {
+		RemoveHighlight(key);
+	}
+
+	if (Streamer.Attached.empty())
+		return;
+
+	std::vector<Analyzer::MeshInput> meshes;
+	meshes.reserve(Streamer.Attached.size());
+	for (const auto& mesh : Streamer.Attached) {
+		meshes.push_back({ mesh.Key, mesh.Points, mesh.Triangles });
+		RemoveHighlight(mesh.Key);
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto report = Analyzer::Analyze(meshes, Analyzer::Thresholds());
+	const auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// report.Meshes is in input order
+	std::vector<DebugAPI_IMPL::LineRenderer::BatchLine> lines;
+	auto raw = Streamer.Attached.begin();
+	for (const auto& mesh : report.Meshes) {
+		while (raw->Key != mesh.Key) {
+			++raw;
+		}
+
+		lines.clear();
+		for (const auto& finding : mesh.Findings) {
+			AddHighlight(*raw, finding, lines);
+		}
+		Highlights[mesh.Key] = DebugAPI_IMPL::DebugAPI::Renderer.CreateBatch(lines);
+	}
+
+	if (report.Meshes.empty()) {
+		logger::debug(FMT_STRING("navmesh check: {} navmeshes, {} triangles fine in {:.2f}ms"), report.MeshCount,
+			report.TriangleCount, milliseconds);
+		return;
+	}
+
+	std::string counts;
+	for (std::uint32_t i = 0; i < Analyzer::kIssueCount; i++) {
+		if (report.Counts[i]) {
+			counts += fmt::format(FMT_STRING("{}{} {}"), counts.empty() ? "" : ", ", report.Counts[i],
+				Analyzer::GetIssueName(static_cast<Analyzer::Issue>(i)));
+		}
+	}
+	logger::info(FMT_STRING("navmesh check: {} of {} navmeshes broken ({}) in {:.2f}ms"), report.Meshes.size(),
+		report.MeshCount, counts, milliseconds);
+}
+
+void NavmeshOverlayWorker::RemoveHighlight(std::uint32_t key)
+{
+	auto highlight = Highlights.find(key);
+	if (highlight == Highlights.end())
+		return;
+
+	DebugAPI_IMPL::DebugAPI::Renderer.DestroyBatch(highlight->second);
+	Highlights.erase(highlight);
+}
+
+void NavmeshOverlayWorker::AddHighlight(const NavmeshStreamer::RawMesh& mesh,
+	const DebugAPI_IMPL::NavmeshAnalyzer::Finding& finding, std::vector<DebugAPI_IMPL::LineRenderer::BatchLine>& lines)
+{
+	// by NavmeshAnalyzer::Issue
+	static constexpr glm::vec4 COLORS[] = {
+		{ 1.0f, 0.0f, 1.0f, 1.0f },  // bad index
+		{ 1.0f, 1.0f, 0.0f, 1.0f },  // degenerate
+		{ 1.0f, 0.5f, 0.0f, 1.0f },  // sliver
+		{ 0.0f, 1.0f, 1.0f, 1.0f },  // duplicate vertex
+		{ 1.0f, 1.0f, 1.0f, 1.0f },  // non-manifold edge
+		{ 0.5f, 0.0f, 1.0f, 1.0f },  // island
+	};
+	static_assert(std::size(COLORS) == DebugAPI_IMPL::NavmeshAnalyzer::kIssueCount);
+
+	// lifted above the wireframe
+	static constexpr glm::vec3 LIFT(0.0f, 0.0f, 8.0f);
+
+	const auto color = DebugAPI_IMPL::DebugAPILine::PackColor(COLORS[finding.Kind]);
+	auto add = [&](const glm::vec3& from, const glm::vec3& to) {
+		lines.push_back({ from, to, color, 4.0f });
+	};
+
+	// a triangle with bad indices is outlined between the vertices that exist
+	std::array<glm::vec3, 3> points;
+	std::uint32_t count = 0;
+	for (auto vertex : mesh.Triangles[finding.Triangle]) {
+		if (vertex < mesh.Points.size()) {
+			points[count++] = mesh.Points[vertex] + LIFT;
+		}
+	}
+
+	if (!count)
+		return;
+
+	for (std::uint32_t i = 0; i + 1 < count; i++) {
+		add(points[i], points[i + 1]);
+	}
+	if (count == 3) {
+		add(points[2], points[0]);
+	}
+
+	// degenerate triangles have no outline to speak of, the marker keeps every finding visible
+	glm::vec3 center(0.0f);
+	for (std::uint32_t i = 0; i < count; i++) {
+		center += points[i];
+	}
+	center /= static_cast<float>(count);
+	add(center, center + glm::vec3(0.0f, 0.0f, 64.0f));
+}
+
 class DebugAPIHook
 {
 public:
@@ -789,9 +2281,19 @@ private:
 	static void Update(RE::PlayerCharacter* a, float delta)
 	{
 		_Update(a, delta);
-		draw_navmeshes();
 
+		if (DebugAPI_IMPL::Settings::NavmeshExport) {
+			NavmeshExporter::GetSingleton().Sync();
+		}
+
+		const auto camera = DebugAPI_IMPL::GetCameraPos();
+		DebugAPI_IMPL::SkeletonCache::GetSingleton().Update(camera, DebugAPI_IMPL::Settings::SkeletonOverlay);
+
+		// the overlay's one render stage per frame. Kick hands over the navmesh lines built during the last frame and
+		// starts building the next ones, which run alongside the rest of this frame
+		NavmeshOverlayWorker::GetSingleton().Kick(camera);
 		DebugAPI_IMPL::DebugAPI::Update();
+		DebugAPI_IMPL::DebugOverlayMenu::FlushLog();
 		//SKSE::GetTaskInterface()->AddUITask([]() { DebugAPI_IMPL::DebugAPI::Update(); });
 	}
 
@@ -802,10 +2304,27 @@ static void SKSEMessageHandler(SKSE::MessagingInterface::Message* message)
 {
 	switch (message->type) {
 	case SKSE::MessagingInterface::kDataLoaded:
-		change_models();
+		DebugAPI_IMPL::Settings::Load();
+		DebugAPI_IMPL::DebugAPI::Renderer.SetBudget(DebugAPI_IMPL::Settings::Budget);
+
+		{
+			FormPatcher patcher;
+			patcher.LoadRules();
+			patcher.Run();
+		}
 
 		DebugAPIHook::Hook();
+		DebugAPI_IMPL::DebugOverlayMenu::Register();
 
+		if (DebugAPI_IMPL::Settings::CaptureEnabled) {
+			DebugAPI_IMPL::DebugAPI::StartCapture();
+		}
+
+		break;
+	case SKSE::MessagingInterface::kNewGame:
+	case SKSE::MessagingInterface::kPostLoadGame:
+		// in case loading closed the overlay menu, showing an open menu again does nothing
+		DebugAPI_IMPL::DebugOverlayMenu::Show();
 		break;
 	}
 }
@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/Capture.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	std::filesystem::path GetTempPath(const char* name) { return std::filesystem::temp_directory_path() / name; }
+
+	std::vector<LineCommand> MakeCommands(std::uint32_t count)
+	{
+		std::vector<LineCommand> commands;
+		for (std::uint32_t i = 0; i < count; i++) {
+			commands.push_back({ glm::vec3(static_cast<float>(i)), glm::vec3(1.0f), i, 1.0f, i + 1u });
+		}
+		return commands;
+	}
+
+	void WriteCapture(const std::filesystem::path& path)
+	{
+		Capture::Writer writer;
+		ASSERT_TRUE(writer.Open(path));
+		writer.WriteFrame(1, CameraSnapshot{}, MakeCommands(10));
+		writer.WriteFrame(2, CameraSnapshot{}, {});
+		writer.WriteFrame(3, CameraSnapshot{}, MakeCommands(3));
+	}
+}
+
+TEST(Capture, RoundTrips)
+{
+	const auto path = GetTempPath("CaptureRoundTrip.capture");
+	WriteCapture(path);
+
+	Capture::Reader reader;
+	ASSERT_TRUE(reader.Open(path));
+
+	Capture::Frame frame;
+	std::vector<std::uint64_t> nows;
+	std::vector<std::size_t> counts;
+	while (reader.ReadFrame(frame)) {
+		nows.push_back(frame.Now);
+		counts.push_back(frame.Commands.size());
+	}
+
+	EXPECT_EQ(nows, (std::vector<std::uint64_t>{ 1, 2, 3 }));
+	EXPECT_EQ(counts, (std::vector<std::size_t>{ 10, 0, 3 }));
+	EXPECT_EQ(frame.Commands.size(), 3u);
+	std::filesystem::remove(path);
+}
+
+TEST(Capture, RejectsTruncatedFrames)
+{
+	const auto path = GetTempPath("CaptureTruncated.capture");
+	WriteCapture(path);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - sizeof(LineCommand));
+
+	Capture::Reader reader;
+	ASSERT_TRUE(reader.Open(path));
+
+	Capture::Frame frame;
+	EXPECT_TRUE(reader.ReadFrame(frame));
+	EXPECT_TRUE(reader.ReadFrame(frame));
+	EXPECT_FALSE(reader.ReadFrame(frame));
+	std::filesystem::remove(path);
+}
+
+TEST(Capture, RejectsCommandCountsBeyondTheFile)
+{
+	const auto path = GetTempPath("CaptureCorrupt.capture");
+	{
+		std::ofstream stream(path, std::ios::binary);
+		const std::uint32_t header[]{ Capture::MAGIC, Capture::VERSION };
+		stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		const std::uint64_t now = 1;
+		const CameraSnapshot camera{};
+		const std::uint32_t commandCount = 0xffffffff;
+		stream.write(reinterpret_cast<const char*>(&now), sizeof(now));
+		stream.write(reinterpret_cast<const char*>(&camera), sizeof(camera));
+		stream.write(reinterpret_cast<const char*>(&commandCount), sizeof(commandCount));
+	}
+
+	Capture::Reader reader;
+	ASSERT_TRUE(reader.Open(path));
+
+	Capture::Frame frame;
+	EXPECT_FALSE(reader.ReadFrame(frame));
+	EXPECT_TRUE(frame.Commands.empty());
+	std::filesystem::remove(path);
+}
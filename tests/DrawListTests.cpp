@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/DrawList.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	// counts what a frame costs in calls into the movie, and keeps the last draw list
+	class RecordingMovie : public OverlayMovie
+	{
+	public:
+		explicit RecordingMovie(bool supportsDrawList) :
+			DrawListSupported(supportsDrawList)
+		{}
+
+		bool SupportsDrawList() const override { return DrawListSupported; }
+
+		void Invoke(const char* method, const float* args, std::uint32_t argCount) override
+		{
+			Methods.emplace_back(method);
+			Args.emplace_back(args, args + argCount);
+			InvokeCount++;
+		}
+
+		void InvokeDrawList(const std::vector<float>& packed) override
+		{
+			Packed = packed;
+			InvokeCount++;
+		}
+
+		bool DrawListSupported;
+		std::vector<std::string> Methods;
+		std::vector<std::vector<float>> Args;
+		std::vector<float> Packed;
+	};
+
+	// thickness, color, alpha and the two endpoints, the lesser one first so the direction doesn't matter
+	using Segment = std::array<float, 7>;
+
+	Segment MakeSegment(float thickness, float color, float alpha, glm::vec2 from, glm::vec2 to)
+	{
+		if (std::make_pair(to.x, to.y) < std::make_pair(from.x, from.y)) {
+			std::swap(from, to);
+		}
+		return { thickness, color, alpha, from.x, from.y, to.x, to.y };
+	}
+
+	std::vector<Segment> Sorted(std::vector<Segment> segments)
+	{
+		std::sort(segments.begin(), segments.end());
+		return segments;
+	}
+
+	// the segments of every polyline in the packed draw list, with the style of its group
+	std::vector<Segment> DecodePacked(const std::vector<float>& packed)
+	{
+		std::vector<Segment> segments;
+		std::size_t pos = 0;
+		const auto groupCount = static_cast<std::uint32_t>(packed.at(pos++));
+		for (std::uint32_t group = 0; group < groupCount; group++) {
+			const float thickness = packed.at(pos++);
+			const float color = packed.at(pos++);
+			const float alpha = packed.at(pos++);
+			const auto polylineCount = static_cast<std::uint32_t>(packed.at(pos++));
+			for (std::uint32_t polyline = 0; polyline < polylineCount; polyline++) {
+				const auto pointCount = static_cast<std::uint32_t>(packed.at(pos++));
+				EXPECT_GE(pointCount, 2u);
+				for (std::uint32_t point = 0; point < pointCount; point++, pos += 2) {
+					if (point) {
+						segments.push_back(MakeSegment(thickness, color, alpha, glm::vec2(packed.at(pos - 2), packed.at(pos - 1)),
+							glm::vec2(packed.at(pos), packed.at(pos + 1))));
+					}
+				}
+			}
+		}
+		EXPECT_EQ(pos, packed.size());
+		return segments;
+	}
+
+	// the same from the fallback's lineStyle, moveTo and lineTo calls
+	std::vector<Segment> DecodeFallback(const RecordingMovie& movie)
+	{
+		std::vector<Segment> segments;
+		std::vector<float> style;
+		glm::vec2 current(0.0f);
+		for (std::size_t i = 0; i < movie.Methods.size(); i++) {
+			const auto& args = movie.Args[i];
+			if (movie.Methods[i] == "lineStyle") {
+				style = args;
+			} else if (movie.Methods[i] == "moveTo") {
+				current = glm::vec2(args.at(0), args.at(1));
+			} else if (movie.Methods[i] == "lineTo") {
+				const glm::vec2 next(args.at(0), args.at(1));
+				segments.push_back(MakeSegment(style.at(0), style.at(1), style.at(2), current, next));
+				current = next;
+			}
+		}
+		return segments;
+	}
+
+	// 64 segment circles of two styles plus unconnected segments, roughly what a frame of shapes looks like
+	void AddFrame(DrawList& list, std::uint32_t circles, std::uint32_t segments)
+	{
+		for (std::uint32_t circle = 0; circle < circles; circle++) {
+			const glm::vec2 center(100.0f + circle * 200.0f, 300.0f);
+			for (std::uint32_t i = 0; i < 64; i++) {
+				auto point = [&](std::uint32_t j) {
+					const float angle = (j % 64) * (6.2831853f / 64.0f);
+					return center + glm::vec2(std::cos(angle), std::sin(angle)) * 50.0f;
+				};
+				list.AddLine(point(i), point(i + 1), circle % 2 ? 255.0f : 65280.0f, 1.0f, 100.0f);
+			}
+		}
+
+		for (std::uint32_t i = 0; i < segments; i++) {
+			const glm::vec2 from(i * 3.0f, 10.0f);
+			list.AddLine(from, from + glm::vec2(1.0f, 5.0f), 65280.0f, 1.0f, 100.0f);
+		}
+	}
+}
+
+TEST(DrawList, SubmitsAFrameInOneInvoke)
+{
+	DrawList list;
+	AddFrame(list, 16, 1000);
+
+	RecordingMovie movie(true);
+	list.Submit(movie);
+
+	EXPECT_EQ(movie.InvokeCount, 1u);
+	EXPECT_TRUE(movie.Methods.empty());
+	ASSERT_FALSE(movie.Packed.empty());
+	EXPECT_EQ(movie.Packed[0], 2.0f);
+}
+
+TEST(DrawList, FallbackInvokesPerPolylinePoint)
+{
+	DrawList list;
+	AddFrame(list, 16, 1000);
+
+	RecordingMovie movie(false);
+	list.Submit(movie);
+
+	// a lineStyle per style, a moveTo per circle and per unconnected segment, a lineTo per segment
+	EXPECT_EQ(movie.InvokeCount, 2u + (16u + 1000u) + (16u * 64u + 1000u));
+	EXPECT_EQ(list.GetLineCount(), 16u * 64u + 1000u);
+	EXPECT_EQ(list.GetPolylineCount(), 16u + 1000u);
+	EXPECT_EQ(movie.Methods.front(), "lineStyle");
+}
+
+TEST(DrawList, EmptyFrameDoesNotInvoke)
+{
+	DrawList list;
+
+	RecordingMovie movie(true);
+	list.Submit(movie);
+
+	EXPECT_EQ(movie.InvokeCount, 0u);
+}
+
+TEST(DrawList, ChainingKeepsEverySegment)
+{
+	constexpr float RED = 16711680.0f;
+	constexpr float GREEN = 65280.0f;
+
+	std::vector<Segment> expected;
+	DrawList list;
+	auto add = [&](glm::vec2 from, glm::vec2 to, float color, float thickness = 1.0f, float alpha = 100.0f) {
+		list.AddLine(from, to, color, thickness, alpha);
+		expected.push_back(MakeSegment(thickness, color, alpha, from, to));
+	};
+
+	// a closed ring, with its segments added out of order and one of them reversed
+	add({ 0.0f, 0.0f }, { 10.0f, 0.0f }, RED);
+	add({ 10.0f, 10.0f }, { 0.0f, 10.0f }, RED);
+	add({ 10.0f, 10.0f }, { 10.0f, 0.0f }, RED);
+	add({ 0.0f, 10.0f }, { 0.0f, 0.0f }, RED);
+
+	// a T-junction, three segments at one point
+	add({ 100.0f, 0.0f }, { 110.0f, 0.0f }, RED);
+	add({ 110.0f, 0.0f }, { 120.0f, 0.0f }, RED);
+	add({ 110.0f, 0.0f }, { 110.0f, 10.0f }, RED);
+
+	// a star, six segments at one point
+	for (int i = 0; i < 6; i++) {
+		add({ 200.0f, 200.0f }, { 200.0f + i * 4.0f, 230.0f }, RED);
+	}
+
+	// the same segment twice
+	add({ 300.0f, 0.0f }, { 310.0f, 5.0f }, RED);
+	add({ 300.0f, 0.0f }, { 310.0f, 5.0f }, RED);
+
+	// sharing endpoints with the ring, but in other styles, which must not be chained with it
+	add({ 10.0f, 0.0f }, { 20.0f, 0.0f }, GREEN);
+	add({ 0.0f, 0.0f }, { 10.0f, 0.0f }, GREEN);
+	add({ 10.0f, 10.0f }, { 20.0f, 20.0f }, RED, 2.0f);
+	add({ 0.0f, 10.0f }, { -10.0f, 10.0f }, RED, 1.0f, 50.0f);
+
+	// many random segments on a small grid, so most points are shared by several segments of several styles
+	std::mt19937 random(3);
+	std::uniform_int_distribution<int> coordinate(0, 15);
+	std::uniform_int_distribution<int> style(0, 2);
+	for (int i = 0; i < 2000; i++) {
+		const glm::vec2 from(400.0f + coordinate(random) * 8.0f, coordinate(random) * 8.0f);
+		const glm::vec2 to(400.0f + coordinate(random) * 8.0f, coordinate(random) * 8.0f);
+		if (from != to) {
+			add(from, to, style(random) ? RED : GREEN, style(random) ? 1.0f : 3.0f);
+		}
+	}
+
+	RecordingMovie drawList(true);
+	list.Submit(drawList);
+	EXPECT_EQ(Sorted(DecodePacked(drawList.Packed)), Sorted(expected));
+	EXPECT_LT(list.GetPolylineCount(), expected.size());
+
+	RecordingMovie fallback(false);
+	list.Submit(fallback);
+	EXPECT_EQ(Sorted(DecodeFallback(fallback)), Sorted(expected));
+}
+
+TEST(DrawList, ClosedRingIsOnePolyline)
+{
+	DrawList list;
+	for (int i = 0; i < 12; i++) {
+		auto point = [](int j) {
+			const float angle = (j % 12) * (6.2831853f / 12.0f);
+			return glm::vec2(std::round(std::cos(angle) * 50.0f), std::round(std::sin(angle) * 50.0f));
+		};
+		list.AddLine(point(i), point(i + 1), 255.0f, 1.0f, 100.0f);
+	}
+
+	RecordingMovie movie(true);
+	list.Submit(movie);
+
+	EXPECT_EQ(list.GetPolylineCount(), 1u);
+	// group count, style, polyline count, then 13 points, the first one repeated at the end
+	ASSERT_EQ(movie.Packed.size(), 1u + 4u + 1u + 13u * 2u);
+	EXPECT_EQ(movie.Packed[5], 13.0f);
+	EXPECT_EQ(movie.Packed[6], movie.Packed[6 + 12 * 2]);
+	EXPECT_EQ(movie.Packed[7], movie.Packed[7 + 12 * 2]);
+}
@@ -0,0 +1,261 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/LineRenderer.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	// same as DebugAPI::DRAW_LOC_MAX_DIF in the plugin
+	constexpr float MAX_DIF = 5.0f;
+
+	constexpr std::uint32_t RED = 0xff0000ff;
+	constexpr std::uint32_t GREEN = 0x00ff00ff;
+	constexpr std::uint32_t BLUE = 0x0000ffff;
+
+	// counts the lines of each frame's draw list by color
+	class CountingMovie : public OverlayMovie
+	{
+	public:
+		bool SupportsDrawList() const override { return true; }
+		void Invoke(const char*, const float*, std::uint32_t) override { InvokeCount++; }
+
+		void InvokeDrawList(const std::vector<float>& packed) override
+		{
+			InvokeCount++;
+			Lines.clear();
+
+			std::size_t pos = 0;
+			const auto groupCount = static_cast<std::uint32_t>(packed[pos++]);
+			for (std::uint32_t group = 0; group < groupCount; group++) {
+				// thickness, color, alpha
+				const auto color = static_cast<std::uint32_t>(packed[pos + 1]);
+				pos += 3;
+				const auto polylineCount = static_cast<std::uint32_t>(packed[pos++]);
+				for (std::uint32_t polyline = 0; polyline < polylineCount; polyline++) {
+					const auto pointCount = static_cast<std::uint32_t>(packed[pos++]);
+					Lines[color] += pointCount - 1;
+					pos += pointCount * 2;
+				}
+			}
+		}
+
+		// drawn lines by 0xRRGGBB
+		std::map<std::uint32_t, std::uint32_t> Lines;
+	};
+
+	// a camera at the origin looking down +y onto a 1280x720 overlay. Row 3 is the view depth
+	CameraSnapshot MakeCamera(float yaw = 0.0f)
+	{
+		CameraSnapshot camera{};
+		const float c = std::cos(yaw);
+		const float s = std::sin(yaw);
+		const float WORLD_TO_CAM[4][4] = {
+			{ c, -s, 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.7777f, 0.0f },
+			{ s, c, 0.0f, -1.0f },
+			{ s, c, 0.0f, 0.0f },
+		};
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++) {
+				camera.WorldToCam[row][col] = WORLD_TO_CAM[row][col];
+			}
+		}
+
+		camera.PortLeft = 0.0f;
+		camera.PortRight = 1.0f;
+		camera.PortTop = 1.0f;
+		camera.PortBottom = 0.0f;
+		camera.RectRight = 1280.0f;
+		camera.RectBottom = 720.0f;
+		return camera;
+	}
+
+	// count vertical lines side by side at the given distance in front of the camera, all of them on screen
+	std::vector<LineRenderer::BatchLine> MakeBatchLines(std::uint32_t count, float distance, std::uint32_t color)
+	{
+		std::vector<LineRenderer::BatchLine> lines;
+		for (std::uint32_t i = 0; i < count; i++) {
+			const float x = (static_cast<float>(i) / count - 0.5f) * distance;
+			lines.push_back({ glm::vec3(x, distance, -0.1f * distance), glm::vec3(x, distance, 0.1f * distance), color, 1.0f });
+		}
+		return lines;
+	}
+
+	std::vector<LineCommand> MakeCommands(std::uint32_t count, float distance, std::uint32_t color,
+		std::uint64_t destroyTickCount)
+	{
+		std::vector<LineCommand> commands;
+		for (const auto& line : MakeBatchLines(count, distance, color)) {
+			commands.push_back({ line.From, line.To, line.Color, line.Thickness, destroyTickCount });
+		}
+		return commands;
+	}
+
+	// renders frames and reads what the last one added to the counters. The counters only keep averages over a
+	// window, so this tracks their running totals
+	class Frames
+	{
+	public:
+		void Render(const CameraSnapshot& camera)
+		{
+			ASSERT_LT(Count, PerfCounters::WINDOW_FRAMES);
+			for (std::uint32_t i = 0; i < PerfCounters::kCounterCount; i++) {
+				Before[i] = GetTotal(static_cast<PerfCounters::Counter>(i));
+			}
+
+			Renderer.RenderFrame(camera, ++Count, Movie);
+		}
+
+		std::uint32_t GetLast(PerfCounters::Counter counter)
+		{
+			return static_cast<std::uint32_t>(std::lround(GetTotal(counter) - Before[counter]));
+		}
+
+		LineRenderer Renderer{ MAX_DIF };
+		CountingMovie Movie;
+
+	private:
+		float GetTotal(PerfCounters::Counter counter) { return Renderer.GetCounters().GetAverage(counter) * Count; }
+
+		std::uint32_t Count = 0;
+		std::array<float, PerfCounters::kCounterCount> Before{};
+	};
+}
+
+TEST(LineRenderer, BatchIsReprojectedOnlyWhenItOrTheCameraChanges)
+{
+	Frames frames;
+	auto& renderer = frames.Renderer;
+	const auto lines = MakeBatchLines(16, 1000.0f, RED);
+	const auto batch = renderer.CreateBatch(lines);
+
+	auto expectReprojected = [&](const CameraSnapshot& camera, std::uint32_t reprojected) {
+		frames.Render(camera);
+		EXPECT_EQ(frames.GetLast(PerfCounters::kReprojected), reprojected);
+		EXPECT_EQ(frames.GetLast(PerfCounters::kBatchLines), 16u);
+		EXPECT_EQ(renderer.GetDrawnLineCount(), 16u);
+	};
+
+	// new, then nothing changed
+	expectReprojected(MakeCamera(), 16);
+	expectReprojected(MakeCamera(), 0);
+	expectReprojected(MakeCamera(), 0);
+
+	EXPECT_TRUE(renderer.SetBatchTransform(batch, glm::mat4(1.0f)));
+	expectReprojected(MakeCamera(), 16);
+	expectReprojected(MakeCamera(), 0);
+
+	EXPECT_TRUE(renderer.SetBatchColor(batch, GREEN));
+	expectReprojected(MakeCamera(), 16);
+	EXPECT_EQ(frames.Movie.Lines, (std::map<std::uint32_t, std::uint32_t>{ { GREEN >> 8, 16 } }));
+	expectReprojected(MakeCamera(), 0);
+
+	expectReprojected(MakeCamera(0.01f), 16);
+	expectReprojected(MakeCamera(0.01f), 0);
+
+	// a lower MinScreenLength can bring back lines the last projection dropped
+	renderer.SetBudget({ 0, 0, 0.5f });
+	expectReprojected(MakeCamera(0.01f), 16);
+	expectReprojected(MakeCamera(0.01f), 0);
+
+	// the camera moves while the batch is hidden, it is projected again once shown
+	EXPECT_TRUE(renderer.SetBatchVisible(batch, false));
+	frames.Render(MakeCamera(0.02f));
+	EXPECT_EQ(frames.GetLast(PerfCounters::kReprojected), 0u);
+	EXPECT_EQ(frames.GetLast(PerfCounters::kBatchLines), 0u);
+	EXPECT_EQ(renderer.GetDrawnLineCount(), 0u);
+
+	EXPECT_TRUE(renderer.SetBatchVisible(batch, true));
+	expectReprojected(MakeCamera(0.02f), 16);
+	expectReprojected(MakeCamera(0.02f), 0);
+
+	// other batches changing doesn't touch this one
+	const auto other = renderer.CreateBatch(MakeBatchLines(4, 500.0f, BLUE));
+	frames.Render(MakeCamera(0.02f));
+	EXPECT_EQ(frames.GetLast(PerfCounters::kReprojected), 4u);
+	EXPECT_TRUE(renderer.SetBatchTransform(other, glm::mat4(1.0f)));
+	frames.Render(MakeCamera(0.02f));
+	EXPECT_EQ(frames.GetLast(PerfCounters::kReprojected), 4u);
+	EXPECT_EQ(renderer.GetDrawnLineCount(), 20u);
+}
+
+TEST(LineRenderer, DestroyBatch)
+{
+	Frames frames;
+	auto& renderer = frames.Renderer;
+	const auto red = renderer.CreateBatch(MakeBatchLines(16, 1000.0f, RED));
+	const auto green = renderer.CreateBatch(MakeBatchLines(8, 1000.0f, GREEN));
+	EXPECT_NE(red, LineRenderer::INVALID_BATCH);
+	EXPECT_NE(red, green);
+	EXPECT_EQ(renderer.GetBatchCount(), 2u);
+
+	frames.Render(MakeCamera());
+	EXPECT_EQ(frames.Movie.Lines, (std::map<std::uint32_t, std::uint32_t>{ { RED >> 8, 16 }, { GREEN >> 8, 8 } }));
+
+	EXPECT_TRUE(renderer.DestroyBatch(red));
+	EXPECT_EQ(renderer.GetBatchCount(), 1u);
+
+	frames.Render(MakeCamera());
+	EXPECT_EQ(frames.Movie.Lines, (std::map<std::uint32_t, std::uint32_t>{ { GREEN >> 8, 8 } }));
+	EXPECT_EQ(frames.GetLast(PerfCounters::kBatchLines), 8u);
+
+	// gone for good, and its handle isn't given out again right away
+	EXPECT_FALSE(renderer.DestroyBatch(red));
+	EXPECT_FALSE(renderer.SetBatchTransform(red, glm::mat4(1.0f)));
+	EXPECT_FALSE(renderer.SetBatchVisible(red, true));
+	EXPECT_FALSE(renderer.SetBatchColor(red, BLUE));
+	EXPECT_FALSE(renderer.DestroyBatch(LineRenderer::INVALID_BATCH));
+	EXPECT_NE(renderer.CreateBatch(MakeBatchLines(1, 1000.0f, BLUE)), red);
+
+	EXPECT_TRUE(renderer.DestroyBatch(green));
+	frames.Render(MakeCamera());
+	EXPECT_EQ(frames.GetLast(PerfCounters::kBatchLines), 1u);
+	EXPECT_EQ(renderer.GetDrawnLineCount(), 1u);
+}
+
+TEST(LineRenderer, BatchesAndPersistentLinesShareTheBudget)
+{
+	Frames frames;
+	auto& renderer = frames.Renderer;
+
+	// the batch is close, the persistent lines are far away and shorter on screen, so they go first
+	renderer.CreateBatch(MakeBatchLines(100, 1000.0f, RED));
+	renderer.Submit(MakeCommands(100, 8000.0f, GREEN, 1000000));
+	renderer.SetBudget({ 150, 0, 1.0f });
+
+	for (int frame = 0; frame < 3; frame++) {
+		frames.Render(MakeCamera());
+		EXPECT_EQ(renderer.GetLiveLineCount(), 100u);
+		EXPECT_EQ(renderer.GetDrawnLineCount(), 150u);
+		EXPECT_EQ(frames.GetLast(PerfCounters::kOverBudget), 50u);
+		EXPECT_EQ(frames.Movie.Lines, (std::map<std::uint32_t, std::uint32_t>{ { RED >> 8, 100 }, { GREEN >> 8, 50 } }));
+	}
+
+	// less than the batch alone
+	renderer.SetBudget({ 60, 0, 1.0f });
+	frames.Render(MakeCamera());
+	EXPECT_EQ(frames.GetLast(PerfCounters::kOverBudget), 140u);
+	EXPECT_EQ(frames.Movie.Lines, (std::map<std::uint32_t, std::uint32_t>{ { RED >> 8, 60 } }));
+
+	// unlimited
+	renderer.SetBudget({ 0, 0, 1.0f });
+	frames.Render(MakeCamera());
+	EXPECT_EQ(frames.GetLast(PerfCounters::kOverBudget), 0u);
+	EXPECT_EQ(frames.Movie.Lines, (std::map<std::uint32_t, std::uint32_t>{ { RED >> 8, 100 }, { GREEN >> 8, 100 } }));
+
+	// transient lines count against it as well
+	renderer.SetBudget({ 250, 0, 1.0f });
+	renderer.Submit(MakeCommands(100, 500.0f, BLUE, LineCommand::TRANSIENT));
+	frames.Render(MakeCamera());
+	EXPECT_EQ(frames.GetLast(PerfCounters::kOverBudget), 50u);
+	EXPECT_EQ(frames.Movie.Lines,
+		(std::map<std::uint32_t, std::uint32_t>{ { RED >> 8, 100 }, { GREEN >> 8, 50 }, { BLUE >> 8, 100 } }));
+}
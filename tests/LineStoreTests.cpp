@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/LineStore.h"
+#include "DebugAPI/Math.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	// same as DebugAPI::DRAW_LOC_MAX_DIF in the plugin
+	constexpr float MAX_DIF = 5.0f;
+
+	// the linear scan LineStore::Find replaced: lines in insertion order, the first one passing the leniency test wins.
+	// Colors and thicknesses are compared the way LineStore stores them, packed
+	class ReferenceScan
+	{
+	public:
+		struct Line
+		{
+			glm::vec3 From;
+			glm::vec3 To;
+			std::uint32_t Color;
+			float Thickness;
+			std::uint32_t Sequence;
+		};
+
+		void Add(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float thickness)
+		{
+			Lines.push_back({ from, to, color, Pack(thickness), NextSequence++ });
+		}
+
+		void Refresh(std::uint32_t sequence, const glm::vec3& from, const glm::vec3& to, float thickness)
+		{
+			auto& line = Get(sequence);
+			line.From = from;
+			line.To = to;
+			line.Thickness = Pack(thickness);
+		}
+
+		void Remove(std::uint32_t sequence) { std::erase_if(Lines, [&](const Line& line) { return line.Sequence == sequence; }); }
+
+		// Sequence of the matching line, ~0u if there is none
+		std::uint32_t Find(const glm::vec3& from, const glm::vec3& to, std::uint32_t color, float thickness) const
+		{
+			for (const auto& line : Lines) {
+				if (IsRoughlyEqual(from.x, line.From.x, MAX_DIF) && IsRoughlyEqual(from.y, line.From.y, MAX_DIF) &&
+					IsRoughlyEqual(from.z, line.From.z, MAX_DIF) && IsRoughlyEqual(to.x, line.To.x, MAX_DIF) &&
+					IsRoughlyEqual(to.y, line.To.y, MAX_DIF) && IsRoughlyEqual(to.z, line.To.z, MAX_DIF) &&
+					IsRoughlyEqual(thickness, line.Thickness, MAX_DIF) && color == line.Color) {
+					return line.Sequence;
+				}
+			}
+			return ~0u;
+		}
+
+		Line& Get(std::uint32_t sequence)
+		{
+			return *std::find_if(Lines.begin(), Lines.end(), [&](const Line& line) { return line.Sequence == sequence; });
+		}
+
+		std::vector<Line> Lines;
+
+	private:
+		static float Pack(float thickness) { return DebugAPILine::PackThickness(thickness) * (1.0f / 16.0f); }
+
+		std::uint32_t NextSequence = 0;
+	};
+
+	std::uint32_t FindSequence(const LineStore& store, const glm::vec3& from, const glm::vec3& to, std::uint32_t color,
+		float thickness)
+	{
+		const auto index = store.Find(from, to, color, thickness);
+		return index == LineStore::INVALID_INDEX ? ~0u : store[index].Sequence;
+	}
+}
+
+TEST(LineStore, MatchesLinearScanOnRandomLines)
+{
+	std::mt19937 random(1234);
+
+	// coordinates cluster on the cell borders (multiples of MAX_DIF), just inside and outside of them and exactly one
+	// MAX_DIF away, where a bucket lookup that probes too few cells would miss a match
+	auto coordinate = [&]() {
+		static constexpr float OFFSETS[] = { 0.0f, 0.001f, -0.001f, 2.5f, 4.999f, -4.999f, MAX_DIF, -MAX_DIF };
+		const float cell = static_cast<float>(std::uniform_int_distribution<int>(-4, 4)(random)) * MAX_DIF;
+		return cell + OFFSETS[std::uniform_int_distribution<std::size_t>(0, std::size(OFFSETS) - 1)(random)];
+	};
+	auto point = [&]() { return glm::vec3(coordinate(), coordinate(), coordinate()); };
+
+	// the second color packs to the same RGBA8 as the first, the third is one step away
+	const std::uint32_t colors[] = {
+		DebugAPILine::PackColor({ 1.0f, 0.0f, 0.0f, 1.0f }),
+		DebugAPILine::PackColor({ 1.0f, 0.0f, 0.001f, 1.0f }),
+		DebugAPILine::PackColor({ 1.0f, 0.0f, 1.0f / 255.0f, 1.0f }),
+		DebugAPILine::PackColor({ 0.0f, 1.0f, 0.0f, 0.5f }),
+	};
+	auto color = [&]() { return colors[std::uniform_int_distribution<std::size_t>(0, std::size(colors) - 1)(random)]; };
+	auto thickness = [&]() { return std::uniform_real_distribution<float>(0.5f, 12.0f)(random); };
+
+	LineStore store(MAX_DIF);
+	ReferenceScan reference;
+
+	// half of the lines are near copies of a live one, so most lookups have candidates right at the leniency limit
+	auto nearby = [&](const glm::vec3& point) {
+		static constexpr float OFFSETS[] = { 0.0f, 0.001f, -0.001f, 2.5f, -4.999f, MAX_DIF, -MAX_DIF, 5.001f };
+		auto offset = [&]() { return OFFSETS[std::uniform_int_distribution<std::size_t>(0, std::size(OFFSETS) - 1)(random)]; };
+		return point + glm::vec3(offset(), offset(), offset());
+	};
+
+	std::uint32_t matches = 0;
+	for (int step = 0; step < 20000; step++) {
+		glm::vec3 from = point();
+		glm::vec3 to = point();
+		if (!reference.Lines.empty() && std::uniform_int_distribution<int>(0, 1)(random)) {
+			const auto& line = reference.Lines[std::uniform_int_distribution<std::size_t>(0, reference.Lines.size() - 1)(random)];
+			from = nearby(line.From);
+			to = nearby(line.To);
+		}
+		const auto lineColor = color();
+		const auto lineThickness = thickness();
+
+		const auto expected = reference.Find(from, to, lineColor, lineThickness);
+		ASSERT_EQ(FindSequence(store, from, to, lineColor, lineThickness), expected) << "step " << step;
+
+		const auto operation = std::uniform_int_distribution<int>(0, 9)(random);
+		if (operation < 6) {
+			// what LineRenderer::ApplyCommand does with a submitted line
+			matches += expected != ~0u;
+			if (expected == ~0u) {
+				store.Add(from, to, lineColor, lineThickness, 0);
+				reference.Add(from, to, lineColor, lineThickness);
+			} else {
+				store.Refresh(store.Find(from, to, lineColor, lineThickness), from, to, lineThickness, 0);
+				reference.Refresh(expected, from, to, lineThickness);
+			}
+		} else if (operation < 8 && store.Size()) {
+			const auto index = std::uniform_int_distribution<std::uint32_t>(0, store.Size() - 1)(random);
+			reference.Remove(store[index].Sequence);
+			store.Remove(index);
+		}
+	}
+
+	ASSERT_EQ(store.Size(), reference.Lines.size());
+	// the comparison is only worth something if plenty of lookups found a line
+	EXPECT_GT(matches, 1000u);
+}
+
+TEST(LineStore, MatchesAcrossCellBorders)
+{
+	LineStore store(MAX_DIF);
+	const auto color = DebugAPILine::PackColor({ 1.0f, 1.0f, 1.0f, 1.0f });
+
+	// start point just below a cell border, every query is in a neighbouring cell
+	const glm::vec3 from(4.999f, -0.001f, 10.0f);
+	const glm::vec3 to(100.0f, 0.0f, 0.0f);
+	const auto line = store.Add(from, to, color, 1.0f, 0);
+
+	EXPECT_EQ(store.Find({ 5.001f, 0.001f, 10.0f }, to, color, 1.0f), line);
+	EXPECT_EQ(store.Find({ 9.999f, 4.999f, 14.999f }, to, color, 1.0f), line);
+	EXPECT_EQ(store.Find({ -0.001f, -5.001f, 5.0f }, to, color, 1.0f), line);
+	// exactly MAX_DIF away, onto the next cell border
+	EXPECT_EQ(store.Find(from + glm::vec3(0.0f, 0.0f, MAX_DIF), to, color, 1.0f), line);
+	// further than MAX_DIF only by the rounding of IsRoughlyEqual's difference, which still calls it equal
+	const auto border = store.Add({ -7.25e-8f, 0.0f, 0.0f }, to, color, 1.0f, 0);
+	EXPECT_EQ(store.Find({ 5.0f, 0.0f, 0.0f }, to, color, 1.0f), border);
+
+	EXPECT_EQ(store.Find({ 10.5f, 0.0f, 10.0f }, to, color, 1.0f), LineStore::INVALID_INDEX);
+	EXPECT_EQ(store.Find(from, to + glm::vec3(0.0f, 0.0f, 5.5f), color, 1.0f), LineStore::INVALID_INDEX);
+}
+
+TEST(LineStore, ComparesColorsAsRGBA8)
+{
+	LineStore store(MAX_DIF);
+	const auto line = store.Add({ 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, DebugAPILine::PackColor({ 1.0f, 0.5f, 0.0f, 1.0f }),
+		1.0f, 0);
+
+	// colors that differ by less than half an 8 bit step are the same line now, the old scan compared the float colors
+	EXPECT_EQ(store.Find({ 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, DebugAPILine::PackColor({ 1.0f, 0.501f, 0.0f, 1.0f }), 1.0f),
+		line);
+	EXPECT_EQ(store.Find({ 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f },
+				  DebugAPILine::PackColor({ 1.0f, 0.5f + 1.0f / 255.0f, 0.0f, 1.0f }), 1.0f),
+		LineStore::INVALID_INDEX);
+	EXPECT_EQ(store.Find({ 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, DebugAPILine::PackColor({ 1.0f, 0.5f, 0.0f, 0.99f }), 1.0f),
+		LineStore::INVALID_INDEX);
+}
+
+TEST(LineStore, ResolvesTiesToTheEarliestLine)
+{
+	LineStore store(MAX_DIF);
+	const auto color = DebugAPILine::PackColor({ 1.0f, 1.0f, 1.0f, 1.0f });
+
+	const auto first = store.Add({ 4.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, color, 1.0f, 0);
+	const auto second = store.Add({ 6.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, color, 1.0f, 0);
+
+	// both match, from different cells
+	EXPECT_EQ(store.Find({ 5.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, color, 1.0f), first);
+
+	// refreshing moves the first line into the second's cell without changing its place in the order
+	store.Refresh(first, { 6.5f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, 1.0f, 0);
+	EXPECT_EQ(store.Find({ 6.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, color, 1.0f), first);
+
+	store.Remove(first);
+	// swap-and-pop moved the second line into the first's index
+	EXPECT_EQ(store.Find({ 6.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, color, 1.0f), first);
+	EXPECT_EQ(store[first].From.x, 6.0f);
+	EXPECT_NE(second, first);
+}
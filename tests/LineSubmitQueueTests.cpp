@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/LineSubmitQueue.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	LineCommand MakeCommand(std::uint32_t index)
+	{
+		return { glm::vec3(static_cast<float>(index), 0.0f, 0.0f), glm::vec3(0.0f), index, 1.0f, 1 };
+	}
+
+	std::vector<std::uint32_t> DrainColors(LineSubmitQueue& queue)
+	{
+		std::vector<std::uint32_t> colors;
+		queue.Drain([&](const LineCommand& command) { colors.push_back(command.Color); });
+		return colors;
+	}
+}
+
+TEST(LineSubmitQueue, ReusesTheQueuesOfExitedThreads)
+{
+	LineSubmitQueue queue;
+
+	std::uint32_t next = 0;
+	for (std::uint32_t i = 0; i < 64; i++) {
+		std::thread([&] {
+			for (std::uint32_t j = 0; j < 100; j++) {
+				queue.Push(MakeCommand(next++));
+			}
+		}).join();
+	}
+
+	EXPECT_EQ(queue.GetProducerCount(), 1u);
+
+	// one producer queue after the other, so still in order
+	const auto colors = DrainColors(queue);
+	ASSERT_EQ(colors.size(), 6400u);
+	for (std::uint32_t i = 0; i < colors.size(); i++) {
+		EXPECT_EQ(colors[i], i);
+	}
+}
+
+TEST(LineSubmitQueue, ConcurrentProducersGetOwnQueues)
+{
+	LineSubmitQueue queue;
+
+	std::vector<std::thread> threads;
+	for (std::uint32_t i = 0; i < 4; i++) {
+		threads.emplace_back([&queue, i] {
+			std::vector<LineCommand> commands;
+			for (std::uint32_t j = 0; j < 5000; j++) {
+				commands.push_back(MakeCommand(i * 5000 + j));
+			}
+			queue.Push(commands);
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_LE(queue.GetProducerCount(), 4u);
+
+	auto colors = DrainColors(queue);
+	std::sort(colors.begin(), colors.end());
+	ASSERT_EQ(colors.size(), 20000u);
+	for (std::uint32_t i = 0; i < colors.size(); i++) {
+		EXPECT_EQ(colors[i], i);
+	}
+}
+
+TEST(LineSubmitQueue, DropsWhatNobodyDrains)
+{
+	LineSubmitQueue queue;
+
+	const std::vector<LineCommand> frame(4096, MakeCommand(0));
+	std::uint32_t pushed = 0;
+	for (std::uint32_t i = 0; i < LineSubmitQueue::MAX_PENDING_CHUNKS; i++) {
+		queue.Push(frame);
+		pushed += static_cast<std::uint32_t>(frame.size());
+	}
+
+	const auto dropped = queue.TakeDroppedCount();
+	EXPECT_GT(dropped, 0u);
+	EXPECT_EQ(queue.TakeDroppedCount(), 0u);
+	EXPECT_EQ(DrainColors(queue).size() + dropped, pushed);
+
+	// drained chunks make room again
+	queue.Push(frame);
+	EXPECT_EQ(queue.TakeDroppedCount(), 0u);
+	EXPECT_EQ(DrainColors(queue).size(), frame.size());
+}
+
+TEST(LineSubmitQueue, OutlivesItsQueuesProducers)
+{
+	auto queue = std::make_unique<LineSubmitQueue>();
+	queue->Push(MakeCommand(1));
+
+	// the thread still holds its producer queue when the LineSubmitQueue goes away, and frees it when it exits
+	std::thread([&] {
+		queue->Push(MakeCommand(2));
+		queue.reset();
+
+		LineSubmitQueue other;
+		other.Push(MakeCommand(3));
+		EXPECT_EQ(DrainColors(other), std::vector<std::uint32_t>{ 3 });
+	}).join();
+}
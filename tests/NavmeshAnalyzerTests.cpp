@@ -0,0 +1,239 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/NavmeshAnalyzer.h"
+
+using namespace DebugAPI_IMPL;
+using namespace DebugAPI_IMPL::NavmeshAnalyzer;
+
+namespace
+{
+	// quads per side of a synthetic mesh
+	constexpr std::uint32_t SYNTHETIC_SIZE = 16;
+
+	struct SyntheticMesh
+	{
+		std::vector<glm::vec3> Vertices;
+		std::vector<std::array<std::uint32_t, 3>> Triangles;
+		// the triangle built to have each issue
+		std::array<std::uint32_t, kIssueCount> Broken{};
+		// the triangles on the non-manifold edge, all three have it
+		std::array<std::uint32_t, 3> NonManifold{};
+	};
+
+	std::uint32_t GetVertex(std::uint32_t x, std::uint32_t y) { return y * (SYNTHETIC_SIZE + 1) + x; }
+
+	// a regular grid, every triangle clean
+	SyntheticMesh MakeGrid(const glm::vec3& origin)
+	{
+		SyntheticMesh mesh;
+		for (std::uint32_t y = 0; y <= SYNTHETIC_SIZE; y++) {
+			for (std::uint32_t x = 0; x <= SYNTHETIC_SIZE; x++) {
+				mesh.Vertices.push_back(origin + glm::vec3(x * 32.0f, y * 32.0f, 0.0f));
+			}
+		}
+
+		for (std::uint32_t y = 0; y < SYNTHETIC_SIZE; y++) {
+			for (std::uint32_t x = 0; x < SYNTHETIC_SIZE; x++) {
+				mesh.Triangles.push_back({ GetVertex(x, y), GetVertex(x + 1, y), GetVertex(x + 1, y + 1) });
+				mesh.Triangles.push_back({ GetVertex(x, y), GetVertex(x + 1, y + 1), GetVertex(x, y + 1) });
+			}
+		}
+		return mesh;
+	}
+
+	// the grid plus one triangle for each issue, everything else is clean
+	SyntheticMesh MakeSyntheticMesh(const glm::vec3& origin)
+	{
+		auto mesh = MakeGrid(origin);
+
+		const auto count = static_cast<std::uint32_t>(mesh.Vertices.size());
+		auto add = [&](const glm::vec3& position) {
+			mesh.Vertices.push_back(position);
+			return static_cast<std::uint32_t>(mesh.Vertices.size() - 1);
+		};
+		auto broken = [&](Issue issue, const std::array<std::uint32_t, 3>& triangle) {
+			mesh.Broken[issue] = static_cast<std::uint32_t>(mesh.Triangles.size());
+			mesh.Triangles.push_back(triangle);
+		};
+
+		broken(kBadIndex, { 0, 1, count + 100 });
+		// repeats a vertex
+		broken(kDegenerate, { 0, 0, 1 });
+		// hanging off the grid's top edge, 1000 units long and 1 unit wide
+		const auto sliverTip = add(origin + glm::vec3(1000.0f, SYNTHETIC_SIZE * 32.0f + 1.0f, 0.0f));
+		broken(kSliver, { GetVertex(0, SYNTHETIC_SIZE), GetVertex(1, SYNTHETIC_SIZE), sliverTip });
+
+		// a clean triangle off the grid's right edge, and one next to it using a copy of grid vertex (SIZE, 4). Both
+		// share an edge with the grid, so neither is an island
+		const auto right = add(origin + glm::vec3(SYNTHETIC_SIZE * 32.0f + 32.0f, 80.0f, 0.0f));
+		mesh.Triangles.push_back({ GetVertex(SYNTHETIC_SIZE, 2), GetVertex(SYNTHETIC_SIZE, 3), right });
+		const auto duplicate = add(mesh.Vertices[GetVertex(SYNTHETIC_SIZE, 4)]);
+		broken(kDuplicateVertex, { GetVertex(SYNTHETIC_SIZE, 3), right, duplicate });
+
+		// a third triangle on the diagonal of quad (1, 1)
+		const auto above = add(origin + glm::vec3(48.0f, 48.0f, 64.0f));
+		broken(kNonManifoldEdge, { GetVertex(1, 1), GetVertex(2, 2), above });
+		const auto quad = 2 * (SYNTHETIC_SIZE + 1);
+		mesh.NonManifold = { quad, quad + 1, mesh.Broken[kNonManifoldEdge] };
+
+		const auto island0 = add(origin + glm::vec3(0.0f, -512.0f, 0.0f));
+		const auto island1 = add(origin + glm::vec3(32.0f, -512.0f, 0.0f));
+		const auto island2 = add(origin + glm::vec3(0.0f, -480.0f, 0.0f));
+		broken(kIsland, { island0, island1, island2 });
+
+		return mesh;
+	}
+
+	MeshInput GetInput(std::uint32_t key, const SyntheticMesh& mesh) { return { key, mesh.Vertices, mesh.Triangles }; }
+
+	// triangle by issue
+	std::multimap<Issue, std::uint32_t> GetFindings(const MeshReport& report)
+	{
+		std::multimap<Issue, std::uint32_t> findings;
+		for (const auto& finding : report.Findings) {
+			findings.emplace(finding.Kind, finding.Triangle);
+		}
+		return findings;
+	}
+}
+
+TEST(NavmeshAnalyzer, CleanGridHasNoFindings)
+{
+	const auto mesh = MakeGrid(glm::vec3(0.0f));
+	EXPECT_TRUE(AnalyzeMesh(GetInput(1, mesh), Thresholds()).Findings.empty());
+}
+
+TEST(NavmeshAnalyzer, FindsEachIssueOnItsTriangle)
+{
+	const auto mesh = MakeSyntheticMesh(glm::vec3(0.0f));
+	const auto report = AnalyzeMesh(GetInput(7, mesh), Thresholds());
+	EXPECT_EQ(report.Key, 7u);
+
+	std::multimap<Issue, std::uint32_t> expected;
+	for (std::uint32_t i = 0; i < kIssueCount; i++) {
+		if (i != kNonManifoldEdge) {
+			expected.emplace(static_cast<Issue>(i), mesh.Broken[i]);
+		}
+	}
+	for (auto triangle : mesh.NonManifold) {
+		expected.emplace(kNonManifoldEdge, triangle);
+	}
+
+	EXPECT_EQ(GetFindings(report), expected);
+}
+
+TEST(NavmeshAnalyzer, OnlySmallGroupsAreIslands)
+{
+	// the grid, a 2 x 2 quad patch next to it and a single quad further out
+	auto mesh = MakeGrid(glm::vec3(0.0f));
+	auto addPatch = [&](const glm::vec3& origin, std::uint32_t size) {
+		const auto first = static_cast<std::uint32_t>(mesh.Vertices.size());
+		for (std::uint32_t y = 0; y <= size; y++) {
+			for (std::uint32_t x = 0; x <= size; x++) {
+				mesh.Vertices.push_back(origin + glm::vec3(x * 32.0f, y * 32.0f, 0.0f));
+			}
+		}
+
+		std::vector<std::uint32_t> triangles;
+		auto vertex = [&](std::uint32_t x, std::uint32_t y) { return first + y * (size + 1) + x; };
+		for (std::uint32_t y = 0; y < size; y++) {
+			for (std::uint32_t x = 0; x < size; x++) {
+				triangles.push_back(static_cast<std::uint32_t>(mesh.Triangles.size()));
+				mesh.Triangles.push_back({ vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1) });
+				triangles.push_back(static_cast<std::uint32_t>(mesh.Triangles.size()));
+				mesh.Triangles.push_back({ vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1) });
+			}
+		}
+		return triangles;
+	};
+	addPatch(glm::vec3(1024.0f, 0.0f, 0.0f), 2);
+	const auto single = addPatch(glm::vec3(2048.0f, 0.0f, 0.0f), 1);
+
+	auto getIslands = [&](const Thresholds& thresholds) {
+		std::vector<std::uint32_t> islands;
+		for (const auto& finding : AnalyzeMesh(GetInput(1, mesh), thresholds).Findings) {
+			EXPECT_EQ(finding.Kind, kIsland);
+			islands.push_back(finding.Triangle);
+		}
+		return islands;
+	};
+
+	// the patch covers 4096 units squared, the single quad 1024
+	EXPECT_EQ(getIslands(Thresholds()), single);
+
+	Thresholds thresholds;
+	thresholds.MaxIslandArea = 4097.0f;
+	EXPECT_EQ(getIslands(thresholds).size(), 8u + 2u);
+	thresholds.MaxIslandArea = 0.0f;
+	EXPECT_TRUE(getIslands(thresholds).empty());
+}
+
+TEST(NavmeshAnalyzer, DuplicateVerticesAreFoundByDistance)
+{
+	// the clean grid, and triangles along its bottom edge using vertices near grid vertices
+	auto mesh = MakeGrid(glm::vec3(0.0f));
+	auto add = [&](const glm::vec3& position) {
+		mesh.Vertices.push_back(position);
+		return static_cast<std::uint32_t>(mesh.Vertices.size() - 1);
+	};
+	auto addTriangle = [&](std::uint32_t x, std::uint32_t near) {
+		const auto below = add(glm::vec3(x * 32.0f + 16.0f, -32.0f, 0.0f));
+		mesh.Triangles.push_back({ GetVertex(x, 0), near, below });
+		return static_cast<std::uint32_t>(mesh.Triangles.size() - 1);
+	};
+
+	const Thresholds thresholds;
+	// 0.01 units from grid vertex (2, 0), but on the other side of a DuplicateDistance cell boundary
+	const auto straddling = addTriangle(1, add(glm::vec3(2 * 32.0f - 0.01f, 0.0f, 0.0f)));
+	// 0.5 units away on each axis, in a different cell on each
+	const auto diagonal = addTriangle(3, add(glm::vec3(4 * 32.0f - 0.5f, -0.5f, -0.5f)));
+	// in the same cell as grid vertex (6, 0) but further away than DuplicateDistance
+	addTriangle(5, add(glm::vec3(6 * 32.0f + 0.99f, 0.99f, 0.99f)));
+	ASSERT_EQ(std::floor(6 * 32.0f / thresholds.DuplicateDistance), std::floor((6 * 32.0f + 0.99f) / thresholds.DuplicateDistance));
+
+	std::vector<std::uint32_t> duplicates;
+	for (const auto& finding : AnalyzeMesh(GetInput(1, mesh), thresholds).Findings) {
+		if (finding.Kind == kDuplicateVertex) {
+			duplicates.push_back(finding.Triangle);
+		}
+	}
+	EXPECT_EQ(duplicates, (std::vector<std::uint32_t>{ straddling, diagonal }));
+}
+
+TEST(NavmeshAnalyzer, AnalyzeReportsBrokenMeshesInInputOrder)
+{
+	// the broken meshes are larger, so Analyze checks them first
+	std::vector<SyntheticMesh> meshes;
+	for (std::uint32_t i = 0; i < 8; i++) {
+		const glm::vec3 origin(i * 4096.0f, 0.0f, 0.0f);
+		meshes.push_back(i % 2 ? MakeGrid(origin) : MakeSyntheticMesh(origin));
+	}
+
+	std::vector<MeshInput> inputs;
+	std::uint64_t triangleCount = 0;
+	for (std::uint32_t i = 0; i < meshes.size(); i++) {
+		inputs.push_back(GetInput(0x100 + i, meshes[i]));
+		triangleCount += meshes[i].Triangles.size();
+	}
+
+	const auto report = Analyze(inputs, Thresholds());
+	EXPECT_EQ(report.MeshCount, meshes.size());
+	EXPECT_EQ(report.TriangleCount, triangleCount);
+
+	ASSERT_EQ(report.Meshes.size(), 4u);
+	for (std::uint32_t i = 0; i < report.Meshes.size(); i++) {
+		EXPECT_EQ(report.Meshes[i].Key, 0x100 + 2 * i);
+		EXPECT_EQ(report.Meshes[i].Findings.size(), kIssueCount - 1 + 3);
+	}
+
+	for (std::uint32_t i = 0; i < kIssueCount; i++) {
+		EXPECT_EQ(report.Counts[i], i == kNonManifoldEdge ? 12u : 4u) << GetIssueName(static_cast<Issue>(i));
+	}
+}
@@ -0,0 +1,183 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/NavmeshExport.h"
+
+using namespace DebugAPI_IMPL;
+using namespace DebugAPI_IMPL::NavmeshExport;
+
+namespace
+{
+	std::filesystem::path GetTempPath(const char* name) { return std::filesystem::temp_directory_path() / name; }
+
+	std::vector<glm::vec3> MakeVertices(std::uint32_t count, float base)
+	{
+		std::vector<glm::vec3> vertices;
+		for (std::uint32_t i = 0; i < count; i++) {
+			vertices.emplace_back(base + i, base - i, base * 0.5f);
+		}
+		return vertices;
+	}
+
+	std::vector<Triangle> MakeTriangles(std::uint32_t count, std::uint32_t vertexCount)
+	{
+		std::vector<Triangle> triangles;
+		for (std::uint32_t i = 0; i < count; i++) {
+			triangles.push_back({ i % vertexCount, (i + 1) % vertexCount, (i + 2) % vertexCount });
+		}
+		return triangles;
+	}
+
+	// two exterior cells and an interior one, added out of order, mesh 0x30 replaced
+	void WriteExport(const std::filesystem::path& path)
+	{
+		Writer writer;
+		writer.AddMesh(0x30, 0x200, 1, 2, MakeVertices(3, 0.0f), MakeTriangles(1, 3));
+		writer.AddMesh(0x20, 0x100, 0, 0, MakeVertices(5, 10.0f), MakeTriangles(4, 5));
+		writer.AddMesh(0x10, 0x200, 1, 2, MakeVertices(7, 20.0f), MakeTriangles(6, 7));
+		writer.AddMesh(0x40, 0x300, INTERIOR, INTERIOR, MakeVertices(4, 30.0f), MakeTriangles(2, 4));
+		writer.AddMesh(0x30, 0x200, 1, 2, MakeVertices(6, 40.0f), MakeTriangles(3, 6));
+		EXPECT_TRUE(writer.HasMesh(0x30));
+		EXPECT_EQ(writer.GetMeshCount(), 4u);
+		ASSERT_TRUE(writer.Write(path, 0x3c, "Tamriel"));
+	}
+
+	template <class T>
+	void Patch(const std::filesystem::path& path, std::size_t offset, const T& value)
+	{
+		std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(offset);
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+}
+
+TEST(NavmeshExport, RoundTrips)
+{
+	const auto path = GetTempPath("NavmeshExportRoundTrip.navmesh");
+	WriteExport(path);
+
+	View view;
+	ASSERT_TRUE(view.Open(path));
+
+	const auto& header = view.GetHeader();
+	EXPECT_EQ(header.WorldFormID, 0x3cu);
+	EXPECT_EQ(std::string(header.WorldName), "Tamriel");
+	EXPECT_EQ(header.VertexCount, 5u + 7u + 6u + 4u);
+	EXPECT_EQ(header.TriangleCount, 4u + 6u + 3u + 2u);
+	EXPECT_EQ(header.FileSize, std::filesystem::file_size(path));
+
+	// cells sorted by FormID, their meshes too
+	const auto cells = view.GetCells();
+	ASSERT_EQ(cells.size(), 3u);
+	EXPECT_EQ(cells[0].FormID, 0x100u);
+	EXPECT_EQ(cells[1].FormID, 0x200u);
+	EXPECT_EQ(cells[1].X, 1);
+	EXPECT_EQ(cells[1].Y, 2);
+	EXPECT_EQ(cells[2].FormID, 0x300u);
+	EXPECT_EQ(cells[2].X, INTERIOR);
+
+	std::vector<std::uint32_t> formIDs;
+	for (const auto& cell : cells) {
+		for (const auto& mesh : view.GetMeshes(cell)) {
+			EXPECT_EQ(&cells[mesh.Cell], &cell);
+			formIDs.push_back(mesh.FormID);
+		}
+	}
+	EXPECT_EQ(formIDs, (std::vector<std::uint32_t>{ 0x20, 0x10, 0x30, 0x40 }));
+
+	struct Expected
+	{
+		std::uint32_t VertexCount;
+		float Base;
+		std::uint32_t TriangleCount;
+	};
+	const Expected expected[]{ { 5, 10.0f, 4 }, { 7, 20.0f, 6 }, { 6, 40.0f, 3 }, { 4, 30.0f, 2 } };
+
+	const auto meshes = view.GetMeshes();
+	ASSERT_EQ(meshes.size(), 4u);
+	for (std::size_t i = 0; i < meshes.size(); i++) {
+		const auto vertices = view.GetVertices(meshes[i]);
+		const auto triangles = view.GetTriangles(meshes[i]);
+		EXPECT_EQ(std::vector<glm::vec3>(vertices.begin(), vertices.end()),
+			MakeVertices(expected[i].VertexCount, expected[i].Base));
+		EXPECT_EQ(std::vector<Triangle>(triangles.begin(), triangles.end()),
+			MakeTriangles(expected[i].TriangleCount, expected[i].VertexCount));
+	}
+
+	view.Close();
+	std::filesystem::remove(path);
+}
+
+TEST(NavmeshExport, EmptyWorldRoundTrips)
+{
+	const auto path = GetTempPath("NavmeshExportEmpty.navmesh");
+	ASSERT_TRUE(Writer().Write(path, 0x3c, ""));
+
+	View view;
+	ASSERT_TRUE(view.Open(path));
+	EXPECT_TRUE(view.GetCells().empty());
+	EXPECT_TRUE(view.GetMeshes().empty());
+
+	view.Close();
+	std::filesystem::remove(path);
+}
+
+TEST(NavmeshExport, RejectsTruncatedFiles)
+{
+	const auto path = GetTempPath("NavmeshExportTruncated.navmesh");
+	WriteExport(path);
+	const auto size = std::filesystem::file_size(path);
+
+	View view;
+	std::filesystem::resize_file(path, size - sizeof(Triangle));
+	EXPECT_FALSE(view.Open(path));
+
+	// not even a header
+	std::filesystem::resize_file(path, sizeof(Header) - 1);
+	EXPECT_FALSE(view.Open(path));
+
+	std::filesystem::remove(path);
+}
+
+TEST(NavmeshExport, RejectsOffsetsBeyondTheFile)
+{
+	const auto path = GetTempPath("NavmeshExportCorrupt.navmesh");
+	View view;
+
+	// past the end, still aligned
+	WriteExport(path);
+	const auto size = std::filesystem::file_size(path);
+	Patch(path, offsetof(Header, VertexOffset), (size + SECTION_ALIGNMENT) / SECTION_ALIGNMENT * SECTION_ALIGNMENT);
+	EXPECT_FALSE(view.Open(path));
+
+	// in range, but the section doesn't fit behind it
+	WriteExport(path);
+	Patch(path, offsetof(Header, TriangleOffset), static_cast<std::uint64_t>(size / SECTION_ALIGNMENT * SECTION_ALIGNMENT));
+	EXPECT_FALSE(view.Open(path));
+
+	// a count large enough to overflow when multiplied
+	WriteExport(path);
+	Patch(path, offsetof(Header, VertexCount), std::uint64_t(1) << 62);
+	EXPECT_FALSE(view.Open(path));
+
+	// a mesh reaching past the vertices
+	WriteExport(path);
+	ASSERT_TRUE(view.Open(path));
+	const auto meshOffset = view.GetHeader().MeshOffset;
+	view.Close();
+	Patch(path, meshOffset + offsetof(Mesh, FirstVertex), std::uint64_t(20));
+	EXPECT_FALSE(view.Open(path));
+
+	// and untouched it opens
+	WriteExport(path);
+	EXPECT_TRUE(view.Open(path));
+
+	view.Close();
+	std::filesystem::remove(path);
+}
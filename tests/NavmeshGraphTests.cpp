@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/NavmeshGraph.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	constexpr float QUAD_SIZE = 100.0f;
+
+	// size x size quads at origin, each quad's two triangles kept with the given chance
+	NavmeshGeometry MakeGrid(std::mt19937& random, const glm::vec3& origin, std::uint32_t size, float keep)
+	{
+		std::vector<glm::vec3> points;
+		for (std::uint32_t y = 0; y <= size; y++) {
+			for (std::uint32_t x = 0; x <= size; x++) {
+				points.push_back(origin + glm::vec3(x * QUAD_SIZE, y * QUAD_SIZE, 0.0f));
+			}
+		}
+
+		std::bernoulli_distribution kept(keep);
+		auto vertex = [size](std::uint32_t x, std::uint32_t y) { return y * (size + 1) + x; };
+		std::vector<std::array<std::uint32_t, 3>> triangles;
+		for (std::uint32_t y = 0; y < size; y++) {
+			for (std::uint32_t x = 0; x < size; x++) {
+				if (kept(random)) {
+					triangles.push_back({ vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1) });
+				}
+				if (kept(random)) {
+					triangles.push_back({ vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1) });
+				}
+			}
+		}
+
+		NavmeshGeometry geometry;
+		geometry.Build(std::move(points), triangles);
+		return geometry;
+	}
+
+	NavmeshGraph BuildGraph(const std::vector<NavmeshGeometry>& meshes)
+	{
+		std::vector<const NavmeshGeometry*> pointers;
+		for (const auto& mesh : meshes) {
+			pointers.push_back(&mesh);
+		}
+
+		NavmeshGraph graph;
+		graph.Build(pointers);
+		return graph;
+	}
+
+	// cost of the cheapest path from start to every node over the graph's links, infinity where there is none
+	std::vector<float> Dijkstra(const NavmeshGraph& graph, std::uint32_t start)
+	{
+		std::vector<float> costs(graph.GetNodeCount(), std::numeric_limits<float>::infinity());
+		using Entry = std::pair<float, std::uint32_t>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+		costs[start] = 0.0f;
+		open.push({ 0.0f, start });
+		while (!open.empty()) {
+			const auto [cost, node] = open.top();
+			open.pop();
+			if (cost > costs[node])
+				continue;
+
+			for (const auto& link : graph.GetLinks(node)) {
+				if (cost + link.Cost < costs[link.Node]) {
+					costs[link.Node] = cost + link.Cost;
+					open.push({ costs[link.Node], link.Node });
+				}
+			}
+		}
+		return costs;
+	}
+
+	// follows the path's portals through the graph from the start node, summing the link costs. Negative if a portal
+	// isn't on a link of the current node or the path doesn't end on goal
+	float GetPathCost(const NavmeshGraph& graph, std::uint32_t start, std::uint32_t goal, const std::vector<glm::vec3>& path)
+	{
+		float cost = 0.0f;
+		auto node = start;
+		for (std::size_t i = 1; i + 1 < path.size(); i++) {
+			const auto links = graph.GetLinks(node);
+			auto link = std::find_if(links.begin(), links.end(),
+				[&](const NavmeshGraph::Link& link) { return link.Portal == path[i]; });
+			if (link == links.end())
+				return -1.0f;
+
+			cost += link->Cost;
+			node = link->Node;
+		}
+		return node == goal ? cost : -1.0f;
+	}
+}
+
+TEST(NavmeshGraph, FindPathMatchesDijkstra)
+{
+	std::mt19937 random(1);
+
+	// two navmeshes meeting at x = 1200, linked through their boundary edges, with holes in both
+	std::vector<NavmeshGeometry> meshes;
+	meshes.push_back(MakeGrid(random, glm::vec3(0.0f), 12, 0.8f));
+	meshes.push_back(MakeGrid(random, glm::vec3(12 * QUAD_SIZE, 0.0f, 0.0f), 12, 0.8f));
+	const auto graph = BuildGraph(meshes);
+
+	NavmeshPathfinder pathfinder;
+	std::vector<glm::vec3> path;
+	std::uniform_int_distribution<std::uint32_t> node(0, graph.GetNodeCount() - 1);
+
+	std::uint32_t found = 0;
+	std::uint32_t crossing = 0;
+	for (int i = 0; i < 200; i++) {
+		const auto start = node(random);
+		const auto goal = node(random);
+		const auto& from = graph.GetCentroid(start);
+		const auto& to = graph.GetCentroid(goal);
+		ASSERT_EQ(graph.FindNode(from), start);
+		ASSERT_EQ(graph.FindNode(to), goal);
+
+		const auto costs = Dijkstra(graph, start);
+		const bool reachable = costs[goal] != std::numeric_limits<float>::infinity();
+		ASSERT_EQ(pathfinder.FindPath(graph, from, to, path, graph.GetNodeCount()), reachable);
+		if (!reachable) {
+			EXPECT_TRUE(path.empty());
+			continue;
+		}
+
+		ASSERT_GE(path.size(), 2u);
+		EXPECT_EQ(path.front(), from);
+		EXPECT_EQ(path.back(), to);
+		EXPECT_NEAR(GetPathCost(graph, start, goal, path), costs[goal], 1e-3f * costs[goal] + 1e-3f);
+
+		found++;
+		crossing += (from.x < 12 * QUAD_SIZE) != (to.x < 12 * QUAD_SIZE);
+	}
+
+	// the holes leave most of it connected, across the two navmeshes too
+	EXPECT_GT(found, 100u);
+	EXPECT_GT(crossing, 20u);
+}
+
+TEST(NavmeshGraph, FindPathFailsWithoutAConnection)
+{
+	std::mt19937 random(2);
+
+	// a gap of one quad between the navmeshes
+	std::vector<NavmeshGeometry> meshes;
+	meshes.push_back(MakeGrid(random, glm::vec3(0.0f), 4, 1.0f));
+	meshes.push_back(MakeGrid(random, glm::vec3(5 * QUAD_SIZE, 0.0f, 0.0f), 4, 1.0f));
+	const auto graph = BuildGraph(meshes);
+
+	NavmeshPathfinder pathfinder;
+	std::vector<glm::vec3> path{ glm::vec3(1.0f) };
+	const glm::vec3 from(50.0f, 50.0f, 0.0f);
+	EXPECT_FALSE(pathfinder.FindPath(graph, from, glm::vec3(850.0f, 350.0f, 0.0f), path));
+	EXPECT_TRUE(path.empty());
+
+	// both sides are still fine on their own
+	EXPECT_TRUE(pathfinder.FindPath(graph, from, glm::vec3(350.0f, 350.0f, 0.0f), path));
+	EXPECT_TRUE(pathfinder.FindPath(graph, glm::vec3(550.0f, 50.0f, 0.0f), glm::vec3(850.0f, 350.0f, 0.0f), path));
+
+	// off the graph
+	EXPECT_FALSE(pathfinder.FindPath(graph, from, glm::vec3(5000.0f, 5000.0f, 0.0f), path));
+}
+
+TEST(NavmeshGraph, FindPathToTheStartNode)
+{
+	std::mt19937 random(3);
+
+	std::vector<NavmeshGeometry> meshes;
+	meshes.push_back(MakeGrid(random, glm::vec3(0.0f), 4, 1.0f));
+	const auto graph = BuildGraph(meshes);
+
+	// both in the lower right triangle of quad (1, 1)
+	const glm::vec3 from(180.0f, 110.0f, 0.0f);
+	const glm::vec3 to(190.0f, 150.0f, 0.0f);
+	ASSERT_EQ(graph.FindNode(from), graph.FindNode(to));
+
+	NavmeshPathfinder pathfinder;
+	std::vector<glm::vec3> path;
+	ASSERT_TRUE(pathfinder.FindPath(graph, from, to, path));
+	EXPECT_EQ(path, (std::vector<glm::vec3>{ from, to }));
+
+	// and the pathfinder's state from that query doesn't leak into the next one
+	ASSERT_TRUE(pathfinder.FindPath(graph, from, glm::vec3(350.0f, 350.0f, 0.0f), path));
+	EXPECT_GT(path.size(), 2u);
+	ASSERT_TRUE(pathfinder.FindPath(graph, to, to, path));
+	EXPECT_EQ(path, (std::vector<glm::vec3>{ to, to }));
+}
+
+TEST(NavmeshGraph, FindNodeOutOfBounds)
+{
+	std::mt19937 random(4);
+
+	std::vector<NavmeshGeometry> meshes;
+	meshes.push_back(MakeGrid(random, glm::vec3(0.0f), 4, 1.0f));
+	const auto graph = BuildGraph(meshes);
+
+	EXPECT_NE(graph.FindNode(glm::vec3(50.0f, 50.0f, 0.0f)), NavmeshGraph::INVALID_NODE);
+	EXPECT_EQ(graph.FindNode(glm::vec3(std::numeric_limits<float>::quiet_NaN(), 50.0f, 0.0f)), NavmeshGraph::INVALID_NODE);
+	EXPECT_EQ(graph.FindNode(glm::vec3(50.0f, 1e30f, 0.0f)), NavmeshGraph::INVALID_NODE);
+
+	NavmeshPathfinder pathfinder;
+	std::vector<glm::vec3> path;
+	EXPECT_FALSE(pathfinder.FindPath(graph, glm::vec3(50.0f, 50.0f, 0.0f), glm::vec3(-1e30f, 0.0f, 0.0f), path));
+}
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/NavmeshGrid.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	// random triangles over a few grid cells, every tenth one large enough to span several cells
+	NavmeshGeometry MakeMesh(std::mt19937& random, const glm::vec3& origin, std::uint32_t triangleCount)
+	{
+		std::uniform_real_distribution<float> position(0.0f, 4.0f * NavmeshGrid::CELL_SIZE);
+		std::uniform_real_distribution<float> small(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> large(-2.5f * NavmeshGrid::CELL_SIZE, 2.5f * NavmeshGrid::CELL_SIZE);
+
+		std::vector<glm::vec3> points;
+		std::vector<std::array<std::uint32_t, 3>> triangles;
+		for (std::uint32_t i = 0; i < triangleCount; i++) {
+			auto& offset = i % 10 ? small : large;
+			const glm::vec3 corner = origin + glm::vec3(position(random), position(random), small(random));
+
+			const auto first = static_cast<std::uint32_t>(points.size());
+			points.push_back(corner);
+			points.push_back(corner + glm::vec3(offset(random), offset(random), small(random)));
+			points.push_back(corner + glm::vec3(offset(random), offset(random), small(random)));
+			triangles.push_back({ first, first + 1, first + 2 });
+
+			// and one sharing an edge with it, so edges and points are shared
+			points.push_back(corner + glm::vec3(offset(random), offset(random), small(random)));
+			triangles.push_back({ first + 1, first + 2, first + 3 });
+		}
+
+		NavmeshGeometry geometry;
+		geometry.Build(std::move(points), triangles);
+		return geometry;
+	}
+
+	// what QueryRadius visited, per mesh key
+	struct RecordingVisitor
+	{
+		explicit RecordingVisitor(const NavmeshGrid& grid)
+		{
+			grid.ForEachMesh([this](std::uint32_t key, const NavmeshGeometry& geometry) { Keys[&geometry] = key; });
+		}
+
+		void Triangle(const NavmeshGeometry& geometry, std::uint32_t triangle)
+		{
+			Triangles.emplace_back(Keys.at(&geometry), triangle);
+		}
+
+		void Edge(const NavmeshGeometry& geometry, std::uint32_t edge) { Edges.emplace_back(Keys.at(&geometry), edge); }
+		void Point(const NavmeshGeometry& geometry, std::uint32_t point) { Points.emplace_back(Keys.at(&geometry), point); }
+
+		std::map<const NavmeshGeometry*, std::uint32_t> Keys;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> Triangles;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> Edges;
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> Points;
+	};
+
+	using Refs = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+	Refs Sorted(Refs refs)
+	{
+		std::sort(refs.begin(), refs.end());
+		return refs;
+	}
+
+	// every triangle of every mesh, with the test QueryRadius applies to the candidates from the grid
+	Refs BruteForce(const std::map<std::uint32_t, NavmeshGeometry>& meshes, const glm::vec3& center, float radius)
+	{
+		Refs triangles;
+		for (const auto& [key, geometry] : meshes) {
+			for (std::uint32_t i = 0; i < geometry.Triangles.size(); i++) {
+				const auto& triangle = geometry.Triangles[i];
+				const auto& p0 = geometry.Points[triangle[0]];
+				const auto& p1 = geometry.Points[triangle[1]];
+				const auto& p2 = geometry.Points[triangle[2]];
+				const auto closest = glm::clamp(center, glm::min(p0, glm::min(p1, p2)), glm::max(p0, glm::max(p1, p2)));
+				if (glm::dot(closest - center, closest - center) <= radius * radius) {
+					triangles.emplace_back(key, i);
+				}
+			}
+		}
+		return triangles;
+	}
+
+	void ExpectMatchesBruteForce(NavmeshGrid& grid, const std::map<std::uint32_t, NavmeshGeometry>& meshes,
+		const glm::vec3& center, float radius)
+	{
+		RecordingVisitor visitor(grid);
+		grid.QueryRadius(center, radius, visitor);
+
+		// sorted, so a triangle visited twice shows up as a mismatch
+		EXPECT_EQ(Sorted(visitor.Triangles), BruteForce(meshes, center, radius));
+
+		// the edges and points are exactly the ones of the visited triangles, each once
+		Refs edges;
+		Refs points;
+		for (const auto& [key, triangle] : visitor.Triangles) {
+			const auto& geometry = meshes.at(key);
+			for (int i = 0; i < 3; i++) {
+				edges.emplace_back(key, geometry.TriangleEdges[triangle][i]);
+				points.emplace_back(key, geometry.Triangles[triangle][i]);
+			}
+		}
+		edges = Sorted(edges);
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		points = Sorted(points);
+		points.erase(std::unique(points.begin(), points.end()), points.end());
+
+		EXPECT_EQ(Sorted(visitor.Edges), edges);
+		EXPECT_EQ(Sorted(visitor.Points), points);
+	}
+}
+
+TEST(NavmeshGrid, QueryRadiusMatchesBruteForce)
+{
+	std::mt19937 random(1);
+	NavmeshGrid grid;
+	std::map<std::uint32_t, NavmeshGeometry> meshes;
+
+	// neighbouring cells, the large triangles reach into each other's
+	for (std::uint32_t i = 0; i < 9; i++) {
+		const glm::vec3 origin((i % 3) * 4.0f * NavmeshGrid::CELL_SIZE, (i / 3) * 4.0f * NavmeshGrid::CELL_SIZE, 0.0f);
+		meshes[0x1000 + i] = MakeMesh(random, origin, 300);
+		grid.AddMesh(0x1000 + i, meshes[0x1000 + i]);
+	}
+
+	std::uniform_real_distribution<float> position(-1000.0f, 13000.0f);
+	std::uniform_real_distribution<float> radius(10.0f, 3000.0f);
+	for (int i = 0; i < 200; i++) {
+		ExpectMatchesBruteForce(grid, meshes, glm::vec3(position(random), position(random), 0.0f), radius(random));
+	}
+}
+
+TEST(NavmeshGrid, AddAndRemoveKeepCellsConsistent)
+{
+	std::mt19937 random(2);
+	NavmeshGrid grid;
+	std::map<std::uint32_t, NavmeshGeometry> meshes;
+
+	auto check = [&] {
+		EXPECT_EQ(grid.GetMeshCount(), meshes.size());
+		for (const auto& [key, geometry] : meshes) {
+			EXPECT_TRUE(grid.HasMesh(key));
+		}
+
+		// large enough to cover everything, plus a few smaller ones
+		ExpectMatchesBruteForce(grid, meshes, glm::vec3(2048.0f, 2048.0f, 0.0f), 20000.0f);
+		for (int i = 0; i < 20; i++) {
+			ExpectMatchesBruteForce(grid, meshes, glm::vec3(i * 300.0f, i * 200.0f, 0.0f), 700.0f);
+		}
+	};
+
+	// all on top of each other, so cells are shared between meshes
+	for (std::uint32_t key = 1; key <= 6; key++) {
+		meshes[key] = MakeMesh(random, glm::vec3(0.0f), 100);
+		grid.AddMesh(key, meshes[key]);
+	}
+	check();
+
+	grid.RemoveMesh(2);
+	meshes.erase(2);
+	grid.RemoveMesh(5);
+	meshes.erase(5);
+	// not indexed, nothing happens
+	grid.RemoveMesh(42);
+	EXPECT_FALSE(grid.HasMesh(2));
+	check();
+
+	// adding an existing key replaces the mesh, new ones reuse the removed slots
+	meshes[3] = MakeMesh(random, glm::vec3(1000.0f, 0.0f, 0.0f), 50);
+	grid.AddMesh(3, meshes[3]);
+	meshes[7] = MakeMesh(random, glm::vec3(0.0f, 1000.0f, 0.0f), 80);
+	grid.AddMesh(7, meshes[7]);
+	check();
+
+	for (auto key : { 1u, 3u, 4u, 6u, 7u }) {
+		grid.RemoveMesh(key);
+		meshes.erase(key);
+	}
+	check();
+	EXPECT_EQ(grid.GetMeshCount(), 0u);
+}
+
+TEST(NavmeshGrid, TriangleSpanningCellsIsVisitedOnce)
+{
+	// covers 10 x 10 grid cells
+	const float size = 10.0f * NavmeshGrid::CELL_SIZE;
+	NavmeshGeometry geometry;
+	geometry.Build({ glm::vec3(-0.5f * size, -0.5f * size, 0.0f), glm::vec3(0.5f * size, -0.5f * size, 0.0f),
+					   glm::vec3(0.0f, 0.5f * size, 0.0f) },
+		{ { 0, 1, 2 } });
+
+	NavmeshGrid grid;
+	grid.AddMesh(1, geometry);
+
+	const std::map<std::uint32_t, NavmeshGeometry> meshes{ { 1, geometry } };
+	for (float radius : { 10.0f, 2.0f * NavmeshGrid::CELL_SIZE, size }) {
+		RecordingVisitor visitor(grid);
+		grid.QueryRadius(glm::vec3(0.0f), radius, visitor);
+		EXPECT_EQ(visitor.Triangles.size(), 1u);
+		EXPECT_EQ(visitor.Edges.size(), 3u);
+		EXPECT_EQ(visitor.Points.size(), 3u);
+	}
+
+	// far from the middle, but inside the triangle's bounds
+	ExpectMatchesBruteForce(grid, meshes, glm::vec3(0.45f * size, 0.45f * size, 0.0f), 10.0f);
+	// outside them
+	ExpectMatchesBruteForce(grid, meshes, glm::vec3(0.0f, 0.7f * size, 0.0f), 100.0f);
+
+	grid.RemoveMesh(1);
+	RecordingVisitor visitor(grid);
+	grid.QueryRadius(glm::vec3(0.0f), size, visitor);
+	EXPECT_TRUE(visitor.Triangles.empty());
+}
+
+TEST(NavmeshGrid, CorruptTrianglesAreSkipped)
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	const float infinity = std::numeric_limits<float>::infinity();
+	NavmeshGeometry geometry;
+	geometry.Build({ glm::vec3(0.0f), glm::vec3(100.0f, 0.0f, 0.0f), glm::vec3(0.0f, 100.0f, 0.0f),
+					   glm::vec3(nan, 0.0f, 0.0f), glm::vec3(0.0f, infinity, 0.0f), glm::vec3(0.0f, 0.0f, 1e30f),
+					   glm::vec3(2.0f * NavmeshGeometry::MAX_COORDINATE, 0.0f, 0.0f),
+					   glm::vec3(0.0f, NavmeshGeometry::MAX_TRIANGLE_SIZE + 1.0f, 0.0f),
+					   glm::vec3(NavmeshGeometry::MAX_TRIANGLE_SIZE - 1.0f, 0.0f, 0.0f) },
+		{ { 0, 1, 2 }, { 0, 1, 3 }, { 0, 1, 4 }, { 0, 1, 5 }, { 0, 1, 6 }, { 0, 1, 7 }, { 0, 2, 8 } });
+
+	// only the first and the last, which is large but not too large
+	EXPECT_EQ(geometry.Triangles, (std::vector<std::array<std::uint32_t, 3>>{ { 0, 1, 2 }, { 0, 2, 8 } }));
+	EXPECT_EQ(geometry.Centroids.size(), 2u);
+	EXPECT_EQ(geometry.Edges.size(), 5u);
+
+	NavmeshGrid grid;
+	grid.AddMesh(1, geometry);
+	const std::map<std::uint32_t, NavmeshGeometry> meshes{ { 1, geometry } };
+	ExpectMatchesBruteForce(grid, meshes, glm::vec3(0.0f), NavmeshGrid::CELL_SIZE);
+	ExpectMatchesBruteForce(grid, meshes, glm::vec3(0.0f), 4.0f * NavmeshGeometry::MAX_TRIANGLE_SIZE);
+
+	// queries out of bounds find nothing
+	for (const auto& center : { glm::vec3(nan, 0.0f, 0.0f), glm::vec3(0.0f, -infinity, 0.0f), glm::vec3(1e30f) }) {
+		RecordingVisitor visitor(grid);
+		grid.QueryRadius(center, 100.0f, visitor);
+		EXPECT_TRUE(visitor.Triangles.empty());
+	}
+	RecordingVisitor visitor(grid);
+	grid.QueryRadius(glm::vec3(0.0f), nan, visitor);
+	EXPECT_TRUE(visitor.Triangles.empty());
+}
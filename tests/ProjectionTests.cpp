@@ -0,0 +1,157 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DebugAPI/Projection.h"
+
+using namespace DebugAPI_IMPL;
+
+namespace
+{
+	// a camera at (100, 200, 50) looking down +y and a little to the side, with a 1280x720 overlay. Row 3 is the view depth
+	CameraSnapshot MakeSnapshot()
+	{
+		CameraSnapshot snapshot{};
+		snapshot.Position = glm::vec3(100.0f, 200.0f, 50.0f);
+
+		const float WORLD_TO_CAM[4][4] = {
+			{ 0.9848f, -0.1736f, 0.0f, -63.76f },
+			{ 0.0f, 0.0f, 1.7777f, -88.885f },
+			{ 0.1736f, 0.9848f, 0.0f, -214.32f },
+			{ 0.1736f, 0.9848f, 0.0f, -214.32f },
+		};
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++) {
+				snapshot.WorldToCam[row][col] = WORLD_TO_CAM[row][col];
+			}
+		}
+
+		snapshot.PortLeft = 0.0f;
+		snapshot.PortRight = 1.0f;
+		snapshot.PortTop = 1.0f;
+		snapshot.PortBottom = 0.0f;
+		snapshot.RectLeft = 0.0f;
+		snapshot.RectRight = 1280.0f;
+		snapshot.RectTop = 0.0f;
+		snapshot.RectBottom = 720.0f;
+		return snapshot;
+	}
+
+	// points all around the camera, so roughly half of them are behind it. Every 16th point is exactly on the w = 0
+	// plane through the camera
+	std::vector<glm::vec3> MakePoints(std::size_t count)
+	{
+		std::mt19937 random(static_cast<std::uint32_t>(count));
+		std::uniform_real_distribution<float> coordinate(-5000.0f, 5000.0f);
+
+		std::vector<glm::vec3> points(count);
+		for (std::size_t i = 0; i < count; i++) {
+			points[i] = glm::vec3(100.0f, 200.0f, 50.0f) + glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+			if (i % 16 == 0) {
+				points[i] = glm::vec3(100.0f, 200.0f, points[i].z);
+			}
+		}
+		return points;
+	}
+
+	void ExpectBatchMatchesScalar(std::size_t count)
+	{
+		const auto snapshot = MakeSnapshot();
+		const auto points = MakePoints(count);
+
+		std::vector<glm::vec4> batch(count);
+		std::vector<glm::vec4> scalar(count);
+		Projection::TransformToClip(snapshot, points.data(), batch.data(), count);
+		Projection::TransformToClipScalar(snapshot, points.data(), scalar.data(), count);
+
+		std::size_t behind = 0;
+		for (std::size_t i = 0; i < count; i++) {
+			// the SSE path evaluates the same multiplies and adds in the same order, the results are bit identical
+			ASSERT_EQ(batch[i].x, scalar[i].x) << "point " << i << " of " << count;
+			ASSERT_EQ(batch[i].y, scalar[i].y) << "point " << i << " of " << count;
+			ASSERT_EQ(batch[i].z, scalar[i].z) << "point " << i << " of " << count;
+			ASSERT_EQ(batch[i].w, scalar[i].w) << "point " << i << " of " << count;
+			behind += scalar[i].w <= 0.0f;
+		}
+
+		if (count >= 16) {
+			EXPECT_GT(behind, count / 4) << count;
+		}
+	}
+}
+
+TEST(Projection, BatchMatchesScalarOnShortBatches)
+{
+	// every tail length after the groups of 4
+	for (std::size_t count = 0; count <= 17; count++) {
+		ExpectBatchMatchesScalar(count);
+	}
+}
+
+TEST(Projection, BatchMatchesScalarOnParallelBatches)
+{
+	static_assert(Projection::PARALLEL_MIN_POINTS % 4 == 0 && Projection::PARALLEL_CHUNK_POINTS % 4 == 0);
+
+	// the last serial size, the first parallel one, and parallel batches whose last chunk is short and ends in a tail
+	ExpectBatchMatchesScalar(Projection::PARALLEL_MIN_POINTS - 1);
+	ExpectBatchMatchesScalar(Projection::PARALLEL_MIN_POINTS);
+	ExpectBatchMatchesScalar(Projection::PARALLEL_MIN_POINTS + 3);
+	ExpectBatchMatchesScalar(Projection::PARALLEL_MIN_POINTS * 3 + Projection::PARALLEL_CHUNK_POINTS / 2 + 1);
+}
+
+TEST(Projection, ProjectPointClampsPointsBehindTheCamera)
+{
+	const auto snapshot = MakeSnapshot();
+
+	// in front of the camera, the plain WorldPtToScreenPt3 math
+	const glm::vec3 front(150.0f, 1200.0f, 80.0f);
+	const auto clip = Projection::TransformToClip(snapshot, front);
+	ASSERT_GT(clip.w, Projection::ZERO_TOLERANCE);
+	const auto screen = Projection::ProjectPoint(snapshot, front);
+	EXPECT_NEAR(screen.x, 1280.0f * (clip.x / clip.w * 0.5f + 0.5f), 1e-3f);
+	EXPECT_NEAR(screen.y, 720.0f * (1.0f - (clip.y / clip.w * 0.5f + 0.5f)), 1e-3f);
+
+	// behind and exactly at the camera, divided by the zero tolerance instead of w
+	for (const glm::vec3 point : { glm::vec3(150.0f, -800.0f, 80.0f), glm::vec3(100.0f, 200.0f, 80.0f) }) {
+		auto clamped = Projection::TransformToClip(snapshot, point);
+		ASSERT_LE(clamped.w, Projection::ZERO_TOLERANCE);
+		clamped.w = Projection::ZERO_TOLERANCE;
+
+		const auto expected = Projection::ClipToScreen(snapshot, clamped);
+		const auto projected = Projection::ProjectPoint(snapshot, point);
+		EXPECT_EQ(projected.x, expected.x);
+		EXPECT_EQ(projected.y, expected.y);
+		EXPECT_TRUE(std::isfinite(projected.x) && std::isfinite(projected.y));
+	}
+}
+
+TEST(Projection, ClipSegmentAgainstTheNearPlane)
+{
+	const auto snapshot = MakeSnapshot();
+
+	// both endpoints behind the camera
+	auto from = Projection::TransformToClip(snapshot, { 100.0f, -500.0f, 50.0f });
+	auto to = Projection::TransformToClip(snapshot, { 120.0f, -50.0f, 60.0f });
+	EXPECT_FALSE(Projection::ClipSegment(from, to));
+
+	// one endpoint behind, one in front, the one behind is moved onto the near plane
+	from = Projection::TransformToClip(snapshot, { 100.0f, -500.0f, 50.0f });
+	to = Projection::TransformToClip(snapshot, { 100.0f, 1500.0f, 50.0f });
+	ASSERT_LT(from.w, 0.0f);
+	ASSERT_TRUE(Projection::ClipSegment(from, to));
+	EXPECT_NEAR(from.w, Projection::NEAR_PLANE_W, 1e-4f);
+	EXPECT_GT(to.w, Projection::NEAR_PLANE_W);
+
+	// one endpoint exactly at the camera, w = 0
+	from = Projection::TransformToClip(snapshot, { 100.0f, 200.0f, 50.0f });
+	to = Projection::TransformToClip(snapshot, { 100.0f, 1500.0f, 50.0f });
+	ASSERT_TRUE(Projection::ClipSegment(from, to));
+	EXPECT_GE(from.w, Projection::NEAR_PLANE_W * 0.99f);
+
+	const auto screenFrom = Projection::ClipToScreen(snapshot, from);
+	EXPECT_TRUE(std::isfinite(screenFrom.x) && std::isfinite(screenFrom.y));
+}
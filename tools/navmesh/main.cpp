@@ -0,0 +1,80 @@
+// runs the navmesh checks (see DebugAPI_IMPL::NavmeshAnalyzer) on a navmesh export written by the plugin, and prints
+// what was found and how long it took. tests/NavmeshAnalyzerTests.cpp checks them on synthetic meshes.
+//
+//   CreationKitInSkyrimNavmeshCheck <export> [--list] [--min-area N] [--min-quality N] [--duplicate-distance N]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "DebugAPI/NavmeshAnalyzer.h"
+#include "DebugAPI/NavmeshExport.h"
+
+using namespace DebugAPI_IMPL;
+
+int main(int argc, char** argv)
+{
+	if (argc < 2) {
+		std::fprintf(stderr,
+			"usage: %s <export> [--list] [--min-area N] [--min-quality N] [--duplicate-distance N] [--max-island-area N]\n",
+			argv[0]);
+		return 1;
+	}
+
+	const char* exportPath = nullptr;
+	bool list = false;
+	NavmeshAnalyzer::Thresholds thresholds;
+	for (int i = 1; i < argc; i++) {
+		if (!std::strcmp(argv[i], "--list")) {
+			list = true;
+		} else if (!std::strcmp(argv[i], "--min-area") && i + 1 < argc) {
+			thresholds.MinArea = static_cast<float>(std::atof(argv[++i]));
+		} else if (!std::strcmp(argv[i], "--min-quality") && i + 1 < argc) {
+			thresholds.MinQuality = static_cast<float>(std::atof(argv[++i]));
+		} else if (!std::strcmp(argv[i], "--duplicate-distance") && i + 1 < argc) {
+			thresholds.DuplicateDistance = static_cast<float>(std::atof(argv[++i]));
+		} else if (!std::strcmp(argv[i], "--max-island-area") && i + 1 < argc) {
+			thresholds.MaxIslandArea = static_cast<float>(std::atof(argv[++i]));
+		} else {
+			exportPath = argv[i];
+		}
+	}
+
+	std::vector<NavmeshAnalyzer::MeshInput> meshes;
+
+	NavmeshExport::View view;
+	if (!exportPath || !view.Open(exportPath)) {
+		std::fprintf(stderr, "%s is not a version %u navmesh export\n", exportPath ? exportPath : "", NavmeshExport::VERSION);
+		return 1;
+	}
+
+	for (const auto& mesh : view.GetMeshes()) {
+		meshes.push_back({ mesh.FormID, view.GetVertices(mesh), view.GetTriangles(mesh) });
+	}
+	std::printf("world:     %s (%08X), %u cells\n", view.GetHeader().WorldName, view.GetHeader().WorldFormID,
+		view.GetHeader().CellCount);
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto report = NavmeshAnalyzer::Analyze(meshes, thresholds);
+	const auto end = std::chrono::steady_clock::now();
+
+	std::printf("meshes:    %llu, %llu triangles in %.2fms\n", static_cast<unsigned long long>(report.MeshCount),
+		static_cast<unsigned long long>(report.TriangleCount), std::chrono::duration<double, std::milli>(end - start).count());
+	std::printf("broken:    %zu meshes\n", report.Meshes.size());
+	for (std::uint32_t i = 0; i < NavmeshAnalyzer::kIssueCount; i++) {
+		std::printf("  %-18s %llu\n", NavmeshAnalyzer::GetIssueName(static_cast<NavmeshAnalyzer::Issue>(i)),
+			static_cast<unsigned long long>(report.Counts[i]));
+	}
+
+	if (list) {
+		for (const auto& mesh : report.Meshes) {
+			for (const auto& finding : mesh.Findings) {
+				std::printf("%08X triangle %u: %s\n", mesh.Key, finding.Triangle, NavmeshAnalyzer::GetIssueName(finding.Kind));
+			}
+		}
+	}
+
+	return 0;
+}
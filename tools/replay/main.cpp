@@ -0,0 +1,149 @@
+// replays a capture written by the plugin (see DebugAPI_IMPL::Capture) through a fresh LineRenderer and reports how
+// long each frame took to render, without the game.
+//
+//   CreationKitInSkyrimReplay <capture> [--repeat N] [--no-draw-list] [--max-lines N] [--max-us N] [--min-length N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "DebugAPI/Capture.h"
+#include "DebugAPI/LineRenderer.h"
+
+using namespace DebugAPI_IMPL;
+
+// same as DebugAPI::DRAW_LOC_MAX_DIF in the plugin
+static constexpr float DRAW_LOC_MAX_DIF = 5.0f;
+
+// stands in for the overlay movie, only counts what would have been sent to Scaleform
+class RecordingMovie : public OverlayMovie
+{
+public:
+	explicit RecordingMovie(bool supportsDrawList) :
+		DrawListSupported(supportsDrawList)
+	{}
+
+	bool SupportsDrawList() const override { return DrawListSupported; }
+
+	void Invoke(const char*, const float*, std::uint32_t argCount) override
+	{
+		InvokeCount++;
+		ArgCount += argCount;
+	}
+
+	void InvokeDrawList(const std::vector<float>& packed) override
+	{
+		InvokeCount++;
+		ArgCount += packed.size();
+	}
+
+	std::uint64_t ArgCount = 0;
+
+private:
+	bool DrawListSupported;
+};
+
+static double Percentile(const std::vector<double>& sorted, double percentile)
+{
+	if (sorted.empty())
+		return 0.0;
+
+	const auto index = static_cast<std::size_t>(percentile * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: %s <capture> [--repeat N] [--no-draw-list] [--max-lines N] [--max-us N] [--min-length N]\n",
+			argv[0]);
+		return 1;
+	}
+
+	int repeat = 1;
+	bool drawList = true;
+	FrameBudget budget;
+	for (int i = 2; i < argc; i++) {
+		if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) {
+			repeat = std::max(1, std::atoi(argv[++i]));
+		} else if (!std::strcmp(argv[i], "--no-draw-list")) {
+			drawList = false;
+		} else if (!std::strcmp(argv[i], "--max-lines") && i + 1 < argc) {
+			budget.MaxLines = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+		} else if (!std::strcmp(argv[i], "--max-us") && i + 1 < argc) {
+			budget.MaxMicroseconds = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+		} else if (!std::strcmp(argv[i], "--min-length") && i + 1 < argc) {
+			budget.MinScreenLength = static_cast<float>(std::atof(argv[++i]));
+		}
+	}
+
+	// read everything up front, so disk reads don't end up in the frame times
+	std::vector<Capture::Frame> frames;
+	{
+		Capture::Reader reader;
+		if (!reader.Open(argv[1])) {
+			std::fprintf(stderr, "%s is not a version %u capture\n", argv[1], Capture::VERSION);
+			return 1;
+		}
+
+		Capture::Frame frame;
+		while (reader.ReadFrame(frame)) {
+			frames.push_back(frame);
+		}
+	}
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(frames.size() * repeat);
+	std::uint64_t commandCount = 0;
+	std::uint64_t invokeCount = 0;
+	std::uint64_t argCount = 0;
+	std::uint64_t drawnLineCount = 0;
+	std::uint32_t maxLiveLineCount = 0;
+	std::string counters;
+
+	for (int run = 0; run < repeat; run++) {
+		LineRenderer renderer(DRAW_LOC_MAX_DIF);
+		renderer.SetBudget(budget);
+
+		for (const auto& frame : frames) {
+			renderer.Submit(frame.Commands);
+			commandCount += frame.Commands.size();
+
+			RecordingMovie movie(drawList);
+			const auto start = std::chrono::steady_clock::now();
+			renderer.RenderFrame(frame.Camera, frame.Now, movie);
+			const auto end = std::chrono::steady_clock::now();
+
+			frameTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+			invokeCount += movie.InvokeCount;
+			argCount += movie.ArgCount;
+			drawnLineCount += renderer.GetDrawnLineCount();
+			maxLiveLineCount = std::max(maxLiveLineCount, renderer.GetLiveLineCount());
+		}
+
+		counters = renderer.GetCounters().Format();
+	}
+
+	if (frameTimes.empty()) {
+		std::printf("%s has no frames\n", argv[1]);
+		return 0;
+	}
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+	const double frameCount = static_cast<double>(frameTimes.size());
+
+	std::printf("frames:        %zu (%zu x %d)\n", frameTimes.size(), frames.size(), repeat);
+	std::printf("commands:      %.1f per frame\n", commandCount / frameCount);
+	std::printf("live lines:    %u max\n", maxLiveLineCount);
+	std::printf("drawn lines:   %.1f per frame\n", drawnLineCount / frameCount);
+	std::printf("invokes:       %.1f per frame, %.1f args per frame\n", invokeCount / frameCount, argCount / frameCount);
+	std::printf("frame time us: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n", Percentile(frameTimes, 0.5),
+		Percentile(frameTimes, 0.9), Percentile(frameTimes, 0.99), frameTimes.back());
+	std::printf("\nper frame, over the end of the last run:\n%s\n", counters.c_str());
+
+	return 0;
+}